@@ -0,0 +1,243 @@
+/**
+ * @file   BigInt/include/BigAccumulator.hpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Library for representing big integers
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BIGINT_BIGACCUMULATOR_HPP
+#define BIGINT_BIGACCUMULATOR_HPP
+
+#include <array>
+#include <climits>
+#include <cstddef>
+
+#include "BigKernel.hpp"
+#include "BigUint.hpp"
+
+namespace Big{
+    namespace detail{
+        /**
+         * r[i] = lane i with the carries of the lanes below resolved,
+         * modulo 2^(n * limb_bits), r may alias lanes
+         */
+        template<class T>
+        BIG_NOINLINE constexpr void resolve_lanes(T* r, const dlimb* lanes, std::size_t n)noexcept{
+            dlimb carry = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                const dlimb t = lanes[i] + carry;
+                // a lane may use all of its bits, the addition can wrap once
+                carry = (t >> limb_bits) + (dlimb(t < carry) << limb_bits);
+                r[i] = limb(t);
+            }
+        }
+
+        // lanes[i] += a[i] for i < n
+        template<class T>
+        BIG_NOINLINE constexpr void add_lanes(dlimb* lanes, const T* a, std::size_t n)noexcept{
+            for(std::size_t i = 0; i < n; ++i)
+                lanes[i] += a[i];
+        }
+
+        /**
+         * adds the partial products of x * y to n lanes, x[i] * y[j] goes
+         * to lanes i + j and i + j + 1, halves above the top lane are
+         * dropped. an >= bn
+         */
+        BIG_NOINLINE constexpr void addmul_lanes(dlimb* lanes, std::size_t n, const limb* x, std::size_t an,
+                                                 const limb* y, std::size_t bn)noexcept{
+            for(std::size_t j = 0; j < bn; ++j){
+                const dlimb yj = y[j];
+                dlimb* l = lanes + j;
+                if(an < n - j){
+                    for(std::size_t i = 0; i < an; ++i){
+                        const dlimb p = x[i] * yj;
+                        l[i] += limb(p);
+                        l[i + 1] += p >> limb_bits;
+                    }
+                }else{
+                    // the row reaches the top lane, its high half is dropped
+                    const std::size_t end = n - j - 1;
+                    for(std::size_t i = 0; i < end; ++i){
+                        const dlimb p = x[i] * yj;
+                        l[i] += limb(p);
+                        l[i + 1] += p >> limb_bits;
+                    }
+                    l[end] += limb(x[end] * yj);
+                }
+            }
+        }
+    }
+
+    /**
+     * sums many values into an N + Extra bit total without
+     * propagating carries on every addition
+     *
+     * every limb of the total is kept in a double width lane, the
+     * high half of a lane collects the carries into the next limb.
+     * the carries are only resolved by result() or when the lanes
+     * could overflow, the total is kept modulo 2^(N + Extra).
+     */
+    template<std::size_t N, std::size_t Extra = 64>
+    class Accumulator{
+        static_assert(!((N + Extra) % (sizeof(unsigned int) * CHAR_BIT)),
+                      "Big::Accumulator: N + Extra must be a multiple of 'sizeof(unsigned int) * CHAR_BIT'");
+
+        using limb  = detail::limb;
+        using dlimb = detail::dlimb;
+
+    public:
+        using result_type = BigUint<N + Extra>;
+
+        static constexpr std::size_t limb_count = result_type::limb_count;
+
+    private:
+        // every lane holds at most units limb sized summands
+        static constexpr dlimb max_units = dlimb(1) << detail::limb_bits;
+
+        std::array<dlimb, limb_count> lanes;
+        dlimb units;
+
+        constexpr void reserve(dlimb n)noexcept;
+        constexpr void normalize()noexcept;
+
+    public:
+        constexpr Accumulator()noexcept;
+
+        constexpr void clear()noexcept;
+
+        template<std::size_t M>
+        constexpr Accumulator& add(const BigUint<M>& x)noexcept;
+
+        // adds a * b
+        template<std::size_t M>
+        constexpr Accumulator& addmul(const BigUint<M>& a, const BigUint<M>& b)noexcept;
+
+        // adds the sum of a[i] * b[i] for i < n
+        template<std::size_t M>
+        constexpr Accumulator& dot(const BigUint<M>* a, const BigUint<M>* b, std::size_t n)noexcept;
+
+        // adds the total of other, for reducing per thread accumulators
+        constexpr Accumulator& merge(const Accumulator& other)noexcept;
+
+        constexpr result_type result()const noexcept;
+    };
+
+    template<std::size_t N, std::size_t Extra>
+    constexpr Accumulator<N, Extra>::Accumulator()noexcept:
+        lanes{},
+        units{1}{}
+
+    template<std::size_t N, std::size_t Extra>
+    constexpr void Accumulator<N, Extra>::clear()noexcept{
+        lanes = {};
+        units = 1;
+    }
+
+    // makes room for n more summands per lane
+    template<std::size_t N, std::size_t Extra>
+    constexpr void Accumulator<N, Extra>::reserve(dlimb n)noexcept{
+        if(units + n > max_units)
+            normalize();
+        units += n;
+    }
+
+    // resolves the carries, afterwards every lane fits into a limb
+    template<std::size_t N, std::size_t Extra>
+    constexpr void Accumulator<N, Extra>::normalize()noexcept{
+        detail::resolve_lanes(lanes.data(), lanes.data(), limb_count);
+        units = 1;
+    }
+
+    template<std::size_t N, std::size_t Extra>
+    template<std::size_t M>
+    constexpr Accumulator<N, Extra>& Accumulator<N, Extra>::add(const BigUint<M>& x)noexcept{
+        const limb* l = x.limbs();
+        const std::size_t n = detail::size(l, BigUint<M>::limb_count < limb_count ? BigUint<M>::limb_count : limb_count);
+        reserve(1);
+        detail::add_lanes(lanes.data(), l, n);
+        return *this;
+    }
+
+    template<std::size_t N, std::size_t Extra>
+    template<std::size_t M>
+    constexpr Accumulator<N, Extra>& Accumulator<N, Extra>::addmul(const BigUint<M>& a, const BigUint<M>& b)noexcept{
+        constexpr std::size_t m = BigUint<M>::limb_count < limb_count ? BigUint<M>::limb_count : limb_count;
+        const limb* x = a.limbs();
+        const limb* y = b.limbs();
+        std::size_t an = detail::size(x, m);
+        std::size_t bn = detail::size(y, m);
+        if(an < bn){
+            const limb* t = x;
+            x = y;
+            y = t;
+            const std::size_t tn = an;
+            an = bn;
+            bn = tn;
+        }
+        if(!bn)
+            return *this;
+
+        // every lane receives at most a low and a high half per row
+        reserve(2 * dlimb(bn));
+        detail::addmul_lanes(lanes.data(), limb_count, x, an, y, bn);
+        return *this;
+    }
+
+    template<std::size_t N, std::size_t Extra>
+    template<std::size_t M>
+    constexpr Accumulator<N, Extra>& Accumulator<N, Extra>::dot(const BigUint<M>* a, const BigUint<M>* b,
+                                                                std::size_t n)noexcept{
+        for(std::size_t i = 0; i < n; ++i)
+            addmul(a[i], b[i]);
+        return *this;
+    }
+
+    template<std::size_t N, std::size_t Extra>
+    constexpr Accumulator<N, Extra>& Accumulator<N, Extra>::merge(const Accumulator& other)noexcept{
+        if(other.units + 1 > max_units){
+            // too full to share the lanes, add its resolved total as one summand
+            std::array<limb, limb_count> t{};
+            detail::resolve_lanes(t.data(), other.lanes.data(), limb_count);
+            reserve(1);
+            detail::add_lanes(lanes.data(), t.data(), limb_count);
+            return *this;
+        }
+        reserve(other.units);
+        detail::add_lanes(lanes.data(), other.lanes.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N, std::size_t Extra>
+    constexpr typename Accumulator<N, Extra>::result_type Accumulator<N, Extra>::result()const noexcept{
+        result_type r{};
+        detail::resolve_lanes(r.limbs(), lanes.data(), limb_count);
+        return r;
+    }
+};
+
+#endif /* BIGINT_BIGACCUMULATOR_HPP */
@@ -34,11 +34,155 @@
 
 #include <array>
 #include <climits>
+#include <cmath>
 #include <istream>
 #include <limits>
 #include <ostream>
+#include <string>
+#include <utility>
+
+#include "BigInt.hpp"
+#include "BigUint.hpp"
 
 namespace Big{
+    namespace detail{
+        /**
+         * the arithmetic of BigFloat on its parts, with the value of x
+         * being (-1)^s * m * 2^e and its exponent limited to
+         * [1 - max_exponent, max_exponent]. the kernels are kept as free
+         * functions so they can stay out of line.
+         */
+        template<std::size_t p>
+        struct float_parts{
+            bool& s;
+            long long& e;
+            BigUint<p>& m;
+            long long max_exponent;
+        };
+
+        // x = (-1)^sign * mantissa * 2^exponent truncated to p bits
+        template<std::size_t p, std::size_t M>
+        BIG_NOINLINE constexpr void float_assign(float_parts<p> x, bool sign, const BigUint<M>& mantissa, long long exponent)noexcept{
+            BigUint<(M > p ? M : p)> wide(mantissa);
+            const std::size_t bits = wide.bit_length();
+            if(!bits){
+                x.s = false;
+                x.e = 0;
+                x.m = BigUint<p>(0ull);
+                return;
+            }
+
+            if(bits > p){
+                wide >>= bits - p;
+                exponent += static_cast<long long>(bits - p);
+            }else{
+                wide <<= p - bits;
+                exponent -= static_cast<long long>(p - bits);
+            }
+
+            if(exponent > x.max_exponent - static_cast<long long>(p - 1)){
+                x.s = sign;
+                x.e = x.max_exponent - static_cast<long long>(p - 1);
+                x.m = ~BigUint<p>(0ull);
+            }else if(exponent < 1 - x.max_exponent - static_cast<long long>(p - 1)){
+                x.s = false;
+                x.e = 0;
+                x.m = BigUint<p>(0ull);
+            }else{
+                x.s = sign;
+                x.e = exponent;
+                x.m = BigUint<p>(wide);
+            }
+        }
+
+        // x += (-1)^sign * m * 2^e, m may alias x.m
+        template<std::size_t p>
+        BIG_NOINLINE constexpr void float_add(float_parts<p> x, bool sign, const BigUint<p>& m, long long e)noexcept{
+            if(!m)
+                return;
+            if(!x.m){
+                x.s = sign;
+                x.e = e;
+                x.m = m;
+                return;
+            }
+
+            bool as = x.s, bs = sign;
+            long long ae = x.e, be = e;
+            const BigUint<p>* am = &x.m;
+            const BigUint<p>* bm = &m;
+            if(ae < be){
+                std::swap(as, bs);
+                std::swap(ae, be);
+                std::swap(am, bm);
+            }
+
+            using wide = BigUint<2 * p + 64>;
+
+            // the smaller operand is entirely below the truncated result
+            if(ae - be > static_cast<long long>(p + 1)){
+                if(as != bs){
+                    // a difference truncates to the next smaller magnitude
+                    wide a(*am);
+                    a <<= 1;
+                    --a;
+                    float_assign(x, as, a, ae - 1);
+                }else if(am != &x.m){
+                    x.s = as;
+                    x.e = ae;
+                    x.m = *am;
+                }
+                return;
+            }
+
+            wide a(*am);
+            a <<= ae - be;
+            wide b(*bm);
+            if(as == bs){
+                a += b;
+                float_assign(x, as, a, be);
+            }else if(b <= a){
+                a -= b;
+                float_assign(x, as, a, be);
+            }else{
+                b -= a;
+                float_assign(x, bs, b, be);
+            }
+        }
+
+        // x *= (-1)^sign * m * 2^e
+        template<std::size_t p>
+        BIG_NOINLINE constexpr void float_mul(float_parts<p> x, bool sign, const BigUint<p>& m, long long e)noexcept{
+            BigUint<2 * p> a(x.m);
+            a *= BigUint<2 * p>(m);
+            float_assign(x, x.s != sign, a, x.e + e);
+        }
+
+        // x /= (-1)^sign * m * 2^e
+        template<std::size_t p>
+        BIG_NOINLINE constexpr void float_div(float_parts<p> x, bool sign, const BigUint<p>& m, long long e)noexcept{
+            if(!x.m)
+                return;
+            if(!m){
+                float_assign(x, x.s, ~BigUint<p>(0ull), x.max_exponent);
+                return;
+            }
+
+            // strip the zero limbs of the divisor so small divisors take the single limb path
+            std::size_t zeros = 0;
+            while(!m.limbs()[zeros])
+                ++zeros;
+
+            using wide = BigUint<2 * p + 64>;
+            wide a(x.m);
+            a <<= p + 1;
+            wide b(m);
+            b >>= zeros * limb_bits;
+            a /= b;
+            float_assign(x, x.s != sign, a, x.e - e - static_cast<long long>(p + 1 + zeros * limb_bits));
+        }
+    }
+
     /**
      * represents an arbitraryly big IEEE754 float
      * in the form:
@@ -47,10 +191,36 @@ namespace Big{
      *   m mantissa (p bits long)
      *   b radix (base = 2)
      *   e exponent (r bits long)
+     *
+     * the mantissa is an integer normalized to exactly p bits and e is
+     * the exponent of its least significant bit, zero has m = 0.
+     * every operation truncates its result towards zero.
      */
     template<std::size_t p, int b, std::size_t r>
     class BigFloat{
+        static_assert(b == 2, "Big::BigFloat: only radix 2 is supported");
+        static_assert(r >= 2 && r <= sizeof(long long) * CHAR_BIT,
+                      "Big::BigFloat: r must be in [2, 'sizeof(long long) * CHAR_BIT']");
+
         bool s;
+        long long e;
+        BigUint<p> m;
+
+        // largest exponent of the most significant mantissa bit, the smallest
+        // is 1 - max_exponent, capped so sums of two exponents can not
+        // overflow a long long
+        static constexpr std::size_t exponent_bits = r < sizeof(long long) * CHAR_BIT - 2 ? r : sizeof(long long) * CHAR_BIT - 2;
+        static constexpr long long max_exponent =
+            static_cast<long long>(~0ull >> (sizeof(long long) * CHAR_BIT - exponent_bits + 1));
+
+        template<std::size_t P, int B, std::size_t R>
+        friend class BigFloat;
+
+        template<std::size_t M>
+        constexpr void assign(bool sign, const BigUint<M>& mantissa, long long exponent)noexcept;
+        template<class T>
+        constexpr void assign_floating(T other)noexcept;
+        constexpr BigFloat& add(const BigFloat& rhs, bool sign)noexcept;
 
     public:
         constexpr BigFloat() = default;
@@ -62,6 +232,13 @@ namespace Big{
         constexpr BigFloat(double other)noexcept;
         constexpr BigFloat(long double other)noexcept;
 
+        template<std::size_t P, std::size_t R>
+        constexpr BigFloat(const BigFloat<P, b, R>& other)noexcept;
+        template<std::size_t N>
+        constexpr BigFloat(const BigUint<N>& other)noexcept;
+        template<std::size_t N>
+        constexpr BigFloat(const BigInt<N>& other)noexcept;
+
         BigFloat& operator=(const BigFloat& other)noexcept;
         BigFloat& operator=(BigFloat&& other)noexcept;
         BigFloat& operator=(long long other)noexcept;
@@ -72,6 +249,16 @@ namespace Big{
 
         void swap(BigFloat& other)noexcept;
 
+        explicit constexpr operator long long()const noexcept;
+        explicit operator double()const noexcept;
+
+        /**
+         * the value is (-1)^sign() * mantissa() * 2^exponent()
+         */
+        constexpr bool sign()const noexcept;
+        constexpr long long exponent()const noexcept;
+        constexpr const BigUint<p>& mantissa()const noexcept;
+
         constexpr BigFloat& operator-()noexcept;
 
         constexpr BigFloat& operator+=(const BigFloat& rhs)noexcept;
@@ -88,23 +275,454 @@ namespace Big{
         constexpr BigFloat& operator--()noexcept;
         constexpr BigFloat operator--(int)noexcept;
 
+        template<std::size_t P, int B, std::size_t R>
+        friend constexpr BigFloat<P, B, R> ldexp(const BigFloat<P, B, R>& x, long long n)noexcept;
+        template<std::size_t P, int B, std::size_t R>
+        friend constexpr BigFloat<P, B, R> trunc(const BigFloat<P, B, R>& x)noexcept;
+
         template<std::size_t P, int B, std::size_t R>
         friend std::ostream& operator<<(std::ostream& os, const BigFloat<P, B, R>& obj);
         template<std::size_t P, int B, std::size_t R>
         friend std::istream& operator>>(std::istream& is, BigFloat<P, B, R>& obj);
     };
 
+    template<std::size_t p, int b, std::size_t r>
+    template<std::size_t M>
+    constexpr void BigFloat<p, b, r>::assign(bool sign, const BigUint<M>& mantissa, long long exponent)noexcept{
+        detail::float_assign(detail::float_parts<p>{s, e, m, max_exponent}, sign, mantissa, exponent);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    template<class T>
+    constexpr void BigFloat<p, b, r>::assign_floating(T other)noexcept{
+        const bool sign = other < 0;
+        if(sign)
+            other = -other;
+        if(!(other > 0) || other != other){
+            assign(false, BigUint<p>(0ull), 0);
+            return;
+        }
+        if(other > std::numeric_limits<T>::max()){
+            assign(sign, ~BigUint<p>(0ull), max_exponent);
+            return;
+        }
+
+        // scale into [2^128, 2^160) where every supported format is integral
+        const T step = T(1ull << 32);
+        const T low = step * step * step * step;
+        const T high = low * step;
+        long long exponent = 0;
+        while(other >= high){
+            other /= step;
+            exponent += 32;
+        }
+        while(other < low){
+            other *= step;
+            exponent -= 32;
+        }
+        assign(sign, BigUint<160>(other), exponent);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::BigFloat(const BigFloat& other)noexcept:
+        s(other.s), e(other.e), m(other.m){}
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::BigFloat(BigFloat&& other)noexcept:
+        s(other.s), e(other.e), m(other.m){}
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::BigFloat(long long other)noexcept:
+        s{}, e{}, m{}{
+        const unsigned long long mag = other < 0 ? 0ull - static_cast<unsigned long long>(other)
+                                                 : static_cast<unsigned long long>(other);
+        assign(other < 0, BigUint<64>(mag), 0);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::BigFloat(unsigned long long other)noexcept:
+        s{}, e{}, m{}{
+        assign(false, BigUint<64>(other), 0);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::BigFloat(float other)noexcept:
+        s{}, e{}, m{}{
+        assign_floating(static_cast<double>(other));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::BigFloat(double other)noexcept:
+        s{}, e{}, m{}{
+        assign_floating(other);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::BigFloat(long double other)noexcept:
+        s{}, e{}, m{}{
+        assign_floating(other);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    template<std::size_t P, std::size_t R>
+    constexpr BigFloat<p, b, r>::BigFloat(const BigFloat<P, b, R>& other)noexcept:
+        s{}, e{}, m{}{
+        assign(other.s, other.m, other.e);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    template<std::size_t N>
+    constexpr BigFloat<p, b, r>::BigFloat(const BigUint<N>& other)noexcept:
+        s{}, e{}, m{}{
+        assign(false, other, 0);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    template<std::size_t N>
+    constexpr BigFloat<p, b, r>::BigFloat(const BigInt<N>& other)noexcept:
+        s{}, e{}, m{}{
+        BigUint<N> mag(0ull);
+        detail::copy(mag.limbs(), other.limbs(), mag.limb_count);
+        const bool sign = mag.limbs()[mag.limb_count - 1] >> (detail::limb_bits - 1);
+        if(sign)
+            detail::negate(mag.limbs(), mag.limb_count);
+        assign(sign, mag, 0);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>& BigFloat<p, b, r>::operator=(const BigFloat& other)noexcept{
+        s = other.s;
+        e = other.e;
+        m = other.m;
+        return *this;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>& BigFloat<p, b, r>::operator=(BigFloat&& other)noexcept{
+        s = other.s;
+        e = other.e;
+        m = other.m;
+        return *this;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>& BigFloat<p, b, r>::operator=(long long other)noexcept{
+        return *this = BigFloat(other);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>& BigFloat<p, b, r>::operator=(unsigned long long other)noexcept{
+        return *this = BigFloat(other);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>& BigFloat<p, b, r>::operator=(float other)noexcept{
+        return *this = BigFloat(other);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>& BigFloat<p, b, r>::operator=(double other)noexcept{
+        return *this = BigFloat(other);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>& BigFloat<p, b, r>::operator=(long double other)noexcept{
+        return *this = BigFloat(other);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    void BigFloat<p, b, r>::swap(BigFloat& other)noexcept{
+        std::swap(s, other.s);
+        std::swap(e, other.e);
+        m.swap(other.m);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>::operator long long()const noexcept{
+        if(!m || e <= -static_cast<long long>(p))
+            return 0;
+        if(e + static_cast<long long>(p) > static_cast<long long>(sizeof(long long) * CHAR_BIT - 1))
+            return s ? std::numeric_limits<long long>::min() : std::numeric_limits<long long>::max();
+
+        BigUint<p + 64> mag(m);
+        if(e < 0)
+            mag >>= -e;
+        else
+            mag <<= e;
+        const long long x = static_cast<long long>(static_cast<unsigned long long>(mag));
+        return s ? -x : x;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r>::operator double()const noexcept{
+        // only the top 64 bits of the mantissa can matter, keep the rest out
+        // of the conversion so wide mantissas don't overflow a double
+        const std::size_t drop = p > 64 ? p - 64 : 0;
+        const long long limit = 1 << 16;
+        const long long shifted = e + static_cast<long long>(drop);
+        const int exponent = static_cast<int>(shifted < -limit ? -limit : shifted > limit ? limit : shifted);
+        const double x = std::ldexp(static_cast<double>(m >> drop), exponent);
+        return s ? -x : x;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr bool BigFloat<p, b, r>::sign()const noexcept{
+        return s;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr long long BigFloat<p, b, r>::exponent()const noexcept{
+        return e;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr const BigUint<p>& BigFloat<p, b, r>::mantissa()const noexcept{
+        return m;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator-()noexcept{
+        if(m)
+            s = !s;
+        return *this;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::add(const BigFloat& rhs, bool sign)noexcept{
+        detail::float_add(detail::float_parts<p>{s, e, m, max_exponent}, sign, rhs.m, rhs.e);
+        return *this;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator+=(const BigFloat& rhs)noexcept{
+        return add(rhs, rhs.s);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator-=(const BigFloat& rhs)noexcept{
+        return add(rhs, !rhs.s);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator*=(const BigFloat& rhs)noexcept{
+        detail::float_mul(detail::float_parts<p>{s, e, m, max_exponent}, rhs.s, rhs.m, rhs.e);
+        return *this;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator/=(const BigFloat& rhs)noexcept{
+        detail::float_div(detail::float_parts<p>{s, e, m, max_exponent}, rhs.s, rhs.m, rhs.e);
+        return *this;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator%=(const BigFloat& rhs)noexcept{
+        if(!rhs.m)
+            return *this;
+        BigFloat q(*this);
+        q /= rhs;
+        q = trunc(q);
+        q *= rhs;
+        return *this -= q;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator++()noexcept{
+        return *this += BigFloat(1ull);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r> BigFloat<p, b, r>::operator++(int)noexcept{
+        BigFloat tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r>& BigFloat<p, b, r>::operator--()noexcept{
+        return *this -= BigFloat(1ull);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r> BigFloat<p, b, r>::operator--(int)noexcept{
+        BigFloat tmp(*this);
+        --*this;
+        return tmp;
+    }
+
+    /**
+     * x * 2^n
+     */
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r> ldexp(const BigFloat<p, b, r>& x, long long n)noexcept{
+        BigFloat<p, b, r> y(x);
+        y.assign(x.s, x.m, x.e + n);
+        return y;
+    }
+
+    /**
+     * exponent of the most significant bit, x must not be zero
+     */
+    template<std::size_t p, int b, std::size_t r>
+    constexpr long long ilogb(const BigFloat<p, b, r>& x)noexcept{
+        return x.exponent() + static_cast<long long>(p - 1);
+    }
+
+    /**
+     * rounds towards zero to an integer
+     */
+    template<std::size_t p, int b, std::size_t r>
+    constexpr BigFloat<p, b, r> trunc(const BigFloat<p, b, r>& x)noexcept{
+        if(x.e >= 0)
+            return x;
+        BigFloat<p, b, r> y(x);
+        if(x.e <= -static_cast<long long>(p)){
+            y.assign(false, BigUint<p>(0ull), 0);
+        }else{
+            BigUint<p> mag(x.m);
+            mag >>= -x.e;
+            mag <<= -x.e;
+            y.assign(x.s, mag, x.e);
+        }
+        return y;
+    }
+
+    namespace detail{
+        template<class F>
+        constexpr F pow_uint(F x, unsigned long long n)noexcept{
+            F y(1ull);
+            while(n){
+                if(n & 1)
+                    y *= x;
+                n >>= 1;
+                if(n)
+                    x *= x;
+            }
+            return y;
+        }
+    }
+
     template<std::size_t p, int b, std::size_t r>
     std::ostream& operator<<(std::ostream& os, const BigFloat<p, b, r>& obj){
-        // write obj to stream
-        return os;
+        using wide = BigFloat<p + 64, b, r>;
+        const std::streamsize precision = os.precision() > 0 ? os.precision() : 1;
+
+        std::string digits;
+        long long exponent = 0;
+        if(!obj.m){
+            digits.assign(static_cast<std::size_t>(precision) + 1, '0');
+        }else{
+            wide x(obj);
+            if(obj.s)
+                -x;
+            const wide ten(10ull);
+
+            exponent = static_cast<long long>(std::floor(static_cast<double>(ilogb(obj)) * 0.30102999566398119521));
+            if(exponent >= 0)
+                x /= detail::pow_uint(ten, static_cast<unsigned long long>(exponent));
+            else
+                x *= detail::pow_uint(ten, static_cast<unsigned long long>(-exponent));
+            while(x >= ten){
+                x /= ten;
+                ++exponent;
+            }
+            while(x < wide(1ull)){
+                x *= ten;
+                --exponent;
+            }
+
+            for(std::streamsize i = 0; i <= precision; ++i){
+                const long long digit = static_cast<long long>(x);
+                digits.push_back(static_cast<char>('0' + digit));
+                x -= wide(digit);
+                x *= ten;
+            }
+        }
+
+        std::string str;
+        if(obj.s)
+            str.push_back('-');
+        else if(os.flags() & std::ios_base::showpos)
+            str.push_back('+');
+        str.push_back(digits[0]);
+        str.push_back('.');
+        str.append(digits, 1, std::string::npos);
+        str.push_back((os.flags() & std::ios_base::uppercase) ? 'E' : 'e');
+        str.push_back(exponent < 0 ? '-' : '+');
+        const std::string exp = std::to_string(exponent < 0 ? -exponent : exponent);
+        if(exp.size() < 2)
+            str.push_back('0');
+        str += exp;
+        return os << str;
     }
 
     template<std::size_t p, int b, std::size_t r>
     std::istream& operator>>(std::istream& is, BigFloat<p, b, r>& obj){
-        // read obj from stream
-        if( /* T could not be constructed */ true )
+        using wide = BigFloat<p + 64, b, r>;
+        using traits = std::istream::traits_type;
+
+        std::istream::sentry sentry(is);
+        if(!sentry)
+            return is;
+
+        int c = is.peek();
+        const bool sign = c == '-';
+        if(sign || c == '+'){
+            is.get();
+            c = is.peek();
+        }
+
+        // collect as many digits as the wide mantissa can hold, count the rest
+        const std::size_t max_digits = (p + 64) * 3 / 10;
+        BigUint<p + 64> mantissa(0ull);
+        const BigUint<p + 64> ten(10ull);
+        std::size_t count = 0;
+        long long exponent = 0;
+        bool any = false;
+        bool point = false;
+        for(; c != traits::eof(); c = is.peek()){
+            if(c == '.' && !point){
+                point = true;
+            }else if(c >= '0' && c <= '9'){
+                any = true;
+                if(count < max_digits){
+                    if(count || c != '0'){
+                        mantissa *= ten;
+                        mantissa += BigUint<p + 64>(static_cast<unsigned long long>(c - '0'));
+                        ++count;
+                    }
+                    if(point)
+                        --exponent;
+                }else if(!point){
+                    ++exponent;
+                }
+            }else{
+                break;
+            }
+            is.get();
+        }
+        if(!any){
             is.setstate(std::ios::failbit);
+            return is;
+        }
+
+        if(c == 'e' || c == 'E'){
+            is.get();
+            long long e10 = 0;
+            if(!(is >> e10))
+                return is;
+            exponent += e10;
+        }
+
+        wide x(mantissa);
+        const wide ten_f(10ull);
+        if(exponent >= 0)
+            x *= detail::pow_uint(ten_f, static_cast<unsigned long long>(exponent));
+        else
+            x /= detail::pow_uint(ten_f, static_cast<unsigned long long>(-exponent));
+        if(sign)
+            -x;
+        obj = BigFloat<p, b, r>(x);
         return is;
     }
 
@@ -137,7 +755,16 @@ namespace Big{
 
     template<std::size_t p, int b, std::size_t r>
     constexpr bool operator< (const BigFloat<p, b, r>& lhs, const BigFloat<p, b, r>& rhs)noexcept{
-        return false; // TODO
+        if(lhs.sign() != rhs.sign())
+            return lhs.sign();
+
+        const BigFloat<p, b, r>& x = lhs.sign() ? rhs : lhs;
+        const BigFloat<p, b, r>& y = lhs.sign() ? lhs : rhs;
+        if(!x.mantissa() || !y.mantissa())
+            return !x.mantissa() && y.mantissa();
+        if(x.exponent() != y.exponent())
+            return x.exponent() < y.exponent();
+        return x.mantissa() < y.mantissa();
     }
     template<std::size_t p, int b, std::size_t r>
     constexpr bool operator> (const BigFloat<p, b, r>& lhs, const BigFloat<p, b, r>& rhs)noexcept{
@@ -154,7 +781,7 @@ namespace Big{
 
     template<std::size_t p, int b, std::size_t r>
     constexpr bool operator==(const BigFloat<p, b, r>& lhs, const BigFloat<p, b, r>& rhs)noexcept{
-        return false; // TODO
+        return lhs.sign() == rhs.sign() && lhs.exponent() == rhs.exponent() && lhs.mantissa() == rhs.mantissa();
     }
     template<std::size_t p, int b, std::size_t r>
     constexpr bool operator!=(const BigFloat<p, b, r>& lhs, const BigFloat<p, b, r>& rhs)noexcept{
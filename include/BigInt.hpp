@@ -34,11 +34,19 @@
 
 #include <array>
 #include <climits>
+#include <cmath>
+#include <functional>
 #include <istream>
 #include <limits>
 #include <ostream>
 
+#include "BigKernel.hpp"
+#include "BigUint.hpp"
+
 namespace Big{
+    /**
+     * represents a signed integer in two's complement
+     */
     template<std::size_t N>
     class BigInt{
         static_assert(!(N % (sizeof(unsigned int) * CHAR_BIT)),
@@ -46,7 +54,14 @@ namespace Big{
 
         std::array<unsigned int, N / (sizeof(unsigned int) * CHAR_BIT)> data;
 
+        template<std::size_t M>
+        friend class BigInt;
+
+        constexpr bool negative()const noexcept;
+
     public:
+        static constexpr std::size_t limb_count = N / (sizeof(unsigned int) * CHAR_BIT);
+
         constexpr BigInt() = default;
         constexpr BigInt(const BigInt& other)noexcept;
         constexpr BigInt(BigInt&& other)noexcept;
@@ -58,17 +73,29 @@ namespace Big{
 
         template<std::size_t M>
         constexpr BigInt(const BigInt<M>& other)noexcept;
+        template<std::size_t M>
+        explicit constexpr BigInt(const BigUint<M>& other)noexcept;
 
-        BigInt& operator=(const BigInt& other)noexcept;
-        BigInt& operator=(BigInt&& other)noexcept;
-        BigInt& operator=(long long other)noexcept;
-        BigInt& operator=(unsigned long long other)noexcept;
-        BigInt& operator=(float other)noexcept;
-        BigInt& operator=(double other)noexcept;
-        BigInt& operator=(long double other)noexcept;
+        constexpr BigInt& operator=(const BigInt& other)noexcept;
+        constexpr BigInt& operator=(BigInt&& other)noexcept;
+        constexpr BigInt& operator=(long long other)noexcept;
+        constexpr BigInt& operator=(unsigned long long other)noexcept;
+        constexpr BigInt& operator=(float other)noexcept;
+        constexpr BigInt& operator=(double other)noexcept;
+        constexpr BigInt& operator=(long double other)noexcept;
 
         void swap(BigInt& other)noexcept;
 
+        explicit constexpr operator bool()const noexcept;
+        explicit constexpr operator long long()const noexcept;
+        explicit operator double()const noexcept;
+
+        /**
+         * raw access to the little endian two's complement limbs
+         */
+        constexpr const unsigned int* limbs()const noexcept;
+        constexpr unsigned int* limbs()noexcept;
+
         constexpr BigInt& operator~()noexcept;
         constexpr BigInt& operator-()noexcept;
 
@@ -95,17 +122,342 @@ namespace Big{
         friend std::istream& operator>>(std::istream& is, BigInt<M>& obj);
     };
 
+    template<std::size_t N>
+    constexpr bool BigInt<N>::negative()const noexcept{
+        return data[limb_count - 1] >> (detail::limb_bits - 1);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::BigInt(const BigInt& other)noexcept:
+        data(other.data){
+        BIG_STATS_ADD(copies, 1);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::BigInt(BigInt&& other)noexcept:
+        data(other.data){
+        BIG_STATS_ADD(copies, 1);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::BigInt(long long other)noexcept:
+        data{}{
+        const unsigned int fill = other < 0 ? ~0u : 0u;
+        unsigned long long x = static_cast<unsigned long long>(other);
+        for(std::size_t i = 0; i < limb_count; ++i){
+            if(i * detail::limb_bits < sizeof(unsigned long long) * CHAR_BIT){
+                data[i] = static_cast<unsigned int>(x);
+                x >>= detail::limb_bits;
+            }else{
+                data[i] = fill;
+            }
+        }
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::BigInt(unsigned long long other)noexcept:
+        data{}{
+        for(std::size_t i = 0; i < limb_count && other; ++i){
+            data[i] = static_cast<unsigned int>(other);
+            other >>= detail::limb_bits;
+        }
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::BigInt(float other)noexcept:
+        data{}{
+        detail::from_floating(data.data(), limb_count, other < 0 ? -other : other);
+        if(other < 0)
+            detail::negate(data.data(), limb_count);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::BigInt(double other)noexcept:
+        data{}{
+        detail::from_floating(data.data(), limb_count, other < 0 ? -other : other);
+        if(other < 0)
+            detail::negate(data.data(), limb_count);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::BigInt(long double other)noexcept:
+        data{}{
+        detail::from_floating(data.data(), limb_count, other < 0 ? -other : other);
+        if(other < 0)
+            detail::negate(data.data(), limb_count);
+    }
+
+    template<std::size_t N>
+    template<std::size_t M>
+    constexpr BigInt<N>::BigInt(const BigInt<M>& other)noexcept:
+        data{}{
+        const unsigned int fill = other.negative() ? ~0u : 0u;
+        for(std::size_t i = 0; i < limb_count; ++i)
+            data[i] = i < other.limb_count ? other.data[i] : fill;
+    }
+
+    template<std::size_t N>
+    template<std::size_t M>
+    constexpr BigInt<N>::BigInt(const BigUint<M>& other)noexcept:
+        data{}{
+        detail::copy(data.data(), other.limbs(), limb_count < other.limb_count ? limb_count : other.limb_count);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator=(const BigInt& other)noexcept{
+        data = other.data;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator=(BigInt&& other)noexcept{
+        data = other.data;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator=(long long other)noexcept{
+        return *this = BigInt(other);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator=(unsigned long long other)noexcept{
+        return *this = BigInt(other);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator=(float other)noexcept{
+        return *this = BigInt(other);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator=(double other)noexcept{
+        return *this = BigInt(other);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator=(long double other)noexcept{
+        return *this = BigInt(other);
+    }
+
+    template<std::size_t N>
+    void BigInt<N>::swap(BigInt& other)noexcept{
+        data.swap(other.data);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::operator bool()const noexcept{
+        return detail::size(data.data(), limb_count) != 0;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>::operator long long()const noexcept{
+        unsigned long long x = negative() ? ~0ull : 0ull;
+        for(std::size_t i = limb_count; i-- > 0;){
+            if(i * detail::limb_bits < sizeof(unsigned long long) * CHAR_BIT)
+                x = (x << detail::limb_bits) | data[i];
+        }
+        return static_cast<long long>(x);
+    }
+
+    template<std::size_t N>
+    BigInt<N>::operator double()const noexcept{
+        BigUint<N> mag(0ull);
+        detail::copy(mag.limbs(), data.data(), limb_count);
+        if(negative()){
+            detail::negate(mag.limbs(), limb_count);
+            return -static_cast<double>(mag);
+        }
+        return static_cast<double>(mag);
+    }
+
+    template<std::size_t N>
+    constexpr const unsigned int* BigInt<N>::limbs()const noexcept{
+        return data.data();
+    }
+
+    template<std::size_t N>
+    constexpr unsigned int* BigInt<N>::limbs()noexcept{
+        return data.data();
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator~()noexcept{
+        for(auto& l : data)
+            l = ~l;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator-()noexcept{
+        detail::negate(data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator+=(const BigInt& rhs)noexcept{
+        detail::add_n(data.data(), data.data(), rhs.data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator-=(const BigInt& rhs)noexcept{
+        detail::sub_n(data.data(), data.data(), rhs.data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator*=(const BigInt& rhs)noexcept{
+        BIG_STATS_ADD(scratch, 1);
+        // multiplies the magnitudes so negative operands keep their short length
+        std::array<unsigned int, limb_count> a = data;
+        std::array<unsigned int, limb_count> b = rhs.data;
+        const bool na = negative();
+        const bool nb = rhs.negative();
+        if(na)
+            detail::negate(a.data(), limb_count);
+        if(nb)
+            detail::negate(b.data(), limb_count);
+        detail::mul_n<limb_count>(data.data(), a.data(), b.data());
+        if(na != nb)
+            detail::negate(data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator/=(const BigInt& rhs)noexcept{
+        BIG_STATS_ADD(scratch, 1);
+        std::array<unsigned int, limb_count> a = data;
+        std::array<unsigned int, limb_count> b = rhs.data;
+        const bool na = negative();
+        const bool nb = rhs.negative();
+        if(na)
+            detail::negate(a.data(), limb_count);
+        if(nb)
+            detail::negate(b.data(), limb_count);
+
+        std::array<unsigned int, limb_count + 1> un{};
+        std::array<unsigned int, limb_count> vn{};
+        detail::divmod(data.data(), nullptr, a.data(), b.data(), limb_count, un.data(), vn.data());
+        if(na != nb)
+            detail::negate(data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator%=(const BigInt& rhs)noexcept{
+        BIG_STATS_ADD(scratch, 1);
+        std::array<unsigned int, limb_count> a = data;
+        std::array<unsigned int, limb_count> b = rhs.data;
+        const bool na = negative();
+        if(na)
+            detail::negate(a.data(), limb_count);
+        if(rhs.negative())
+            detail::negate(b.data(), limb_count);
+
+        std::array<unsigned int, limb_count + 1> un{};
+        std::array<unsigned int, limb_count> vn{};
+        detail::divmod(nullptr, data.data(), a.data(), b.data(), limb_count, un.data(), vn.data());
+        if(na)
+            detail::negate(data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator^=(const BigInt& rhs)noexcept{
+        for(std::size_t i = 0; i < limb_count; ++i)
+            data[i] ^= rhs.data[i];
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator&=(const BigInt& rhs)noexcept{
+        for(std::size_t i = 0; i < limb_count; ++i)
+            data[i] &= rhs.data[i];
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator|=(const BigInt& rhs)noexcept{
+        for(std::size_t i = 0; i < limb_count; ++i)
+            data[i] |= rhs.data[i];
+        return *this;
+    }
+
+    template<std::size_t N>
+    template<class IntType>
+    constexpr BigInt<N>& BigInt<N>::operator<<=(IntType shift)noexcept{
+        if(shift > 0)
+            detail::shl(data.data(), limb_count, static_cast<std::size_t>(shift));
+        return *this;
+    }
+
+    template<std::size_t N>
+    template<class IntType>
+    constexpr BigInt<N>& BigInt<N>::operator>>=(IntType shift)noexcept{
+        if(shift > 0)
+            detail::shr(data.data(), limb_count, static_cast<std::size_t>(shift), negative() ? ~0u : 0u);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator++()noexcept{
+        detail::add_1(data.data(), data.data(), limb_count, 1);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N> BigInt<N>::operator++(int)noexcept{
+        BigInt tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N>& BigInt<N>::operator--()noexcept{
+        detail::sub_1(data.data(), data.data(), limb_count, 1);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N> BigInt<N>::operator--(int)noexcept{
+        BigInt tmp(*this);
+        --*this;
+        return tmp;
+    }
+
     template<std::size_t N>
     std::ostream& operator<<(std::ostream& os, const BigInt<N>& obj){
-        // write obj to stream
-        return os;
+        auto tmp = obj.data;
+        std::string sign;
+        if(obj.negative()){
+            detail::negate(tmp.data(), tmp.size());
+            sign = "-";
+        }else if(os.flags() & std::ios_base::showpos){
+            sign = "+";
+        }
+        return os << sign + detail::to_string(tmp.data(), tmp.size(), os.flags());
     }
 
     template<std::size_t N>
     std::istream& operator>>(std::istream& is, BigInt<N>& obj){
-        // read obj from stream
-        if( /* T could not be constructed */ true )
+        std::istream::sentry sentry(is);
+        if(!sentry)
+            return is;
+
+        const int c = is.peek();
+        const bool neg = c == '-';
+        if(neg || c == '+')
+            is.get();
+
+        decltype(obj.data) tmp{};
+        if(detail::from_stream(is, tmp.data(), tmp.size())){
+            if(neg)
+                detail::negate(tmp.data(), tmp.size());
+            obj.data = tmp;
+        }else{
             is.setstate(std::ios::failbit);
+        }
         return is;
     }
 
@@ -148,18 +500,23 @@ namespace Big{
     }
 
     template <std::size_t N, class IntType>
-    constexpr BigInt<N> operator<<(const BigInt<N>& lhs, IntType shift)noexcept{
+    constexpr BigInt<N> operator<<(BigInt<N> lhs, IntType shift)noexcept{
         return lhs <<= shift;
     }
     template <std::size_t N, class IntType>
-    constexpr BigInt<N> operator>>(const BigInt<N>& lhs, IntType shift)noexcept{
+    constexpr BigInt<N> operator>>(BigInt<N> lhs, IntType shift)noexcept{
         return lhs >>= shift;
     }
 
 
     template<std::size_t N>
     constexpr bool operator< (const BigInt<N>& lhs, const BigInt<N>& rhs) noexcept {
-        return false; // TODO
+        const std::size_t top = BigInt<N>::limb_count - 1;
+        const bool ln = lhs.limbs()[top] >> (detail::limb_bits - 1);
+        const bool rn = rhs.limbs()[top] >> (detail::limb_bits - 1);
+        if(ln != rn)
+            return ln;
+        return detail::cmp(lhs.limbs(), rhs.limbs(), BigInt<N>::limb_count) < 0;
     }
     template<std::size_t N>
     constexpr bool operator> (const BigInt<N>& lhs, const BigInt<N>& rhs) noexcept {
@@ -176,12 +533,111 @@ namespace Big{
 
     template<std::size_t N>
     constexpr bool operator==(const BigInt<N>& lhs, const BigInt<N>& rhs) noexcept {
-        return false;
+        return detail::cmp(lhs.limbs(), rhs.limbs(), BigInt<N>::limb_count) == 0;
     }
     template<std::size_t N>
     constexpr bool operator!=(const BigInt<N>& lhs, const BigInt<N>& rhs) noexcept {
         return !(lhs == rhs);
     }
+
+    /**
+     * minimal uses the fewest two's complement bytes that still
+     * carry the sign, none for zero
+     */
+    template<std::size_t N>
+    constexpr std::size_t export_size(const BigInt<N>& x, byte_width width = byte_width::fixed)noexcept{
+        if(width == byte_width::fixed)
+            return N / CHAR_BIT;
+        const unsigned int* l = x.limbs();
+        const unsigned int fill = l[BigInt<N>::limb_count - 1] >> (detail::limb_bits - 1) ? ~0u : 0u;
+        std::size_t n = BigInt<N>::limb_count;
+        while(n && l[n - 1] == fill)
+            --n;
+        if(!n)
+            return fill ? 1 : 0;
+        // significant bits below the sign bit
+        const std::size_t bits = n * detail::limb_bits - detail::clz(fill ^ l[n - 1]);
+        return bits / CHAR_BIT + 1;
+    }
+
+    template<std::size_t N>
+    constexpr std::size_t export_bytes(const BigInt<N>& x, unsigned char* out,
+                                       byte_order order = byte_order::little,
+                                       byte_width width = byte_width::fixed)noexcept{
+        const std::size_t size = export_size(x, width);
+        detail::export_bytes(out, x.limbs(), BigInt<N>::limb_count, size, order == byte_order::big);
+        return size;
+    }
+
+    /**
+     * reads size two's complement bytes from in into x, sign extending
+     * from the most significant byte, returns false if the value did
+     * not fit
+     */
+    template<std::size_t N>
+    constexpr bool import_bytes(BigInt<N>& x, const unsigned char* in, std::size_t size,
+                                byte_order order = byte_order::little)noexcept{
+        if(!size){
+            detail::zero(x.limbs(), BigInt<N>::limb_count);
+            return true;
+        }
+        const unsigned char top = in[order == byte_order::big ? 0 : size - 1];
+        const unsigned char fill = top >> (CHAR_BIT - 1) ? static_cast<unsigned char>(~0u) : 0;
+        const bool fits = detail::import_bytes(x.limbs(), BigInt<N>::limb_count, in, size,
+                                               order == byte_order::big, fill);
+        const bool sign = x.limbs()[BigInt<N>::limb_count - 1] >> (detail::limb_bits - 1);
+        return fits && sign == bool(fill);
+    }
+
+    /**
+     * Big::signed_literal<256>("-1234"), like Big::literal with an
+     * optional leading minus, the value must lie in [-2^(N-1), 2^(N-1))
+     */
+    template<std::size_t N, std::size_t L>
+    constexpr BigInt<N> signed_literal(const char (&s)[L])noexcept{
+        const bool negative = L > 1 && s[0] == '-';
+        const char* digits = s + negative;
+        const std::size_t len = L - 1 - negative;
+
+        BigInt<N> x{};
+        constexpr std::size_t n = BigInt<N>::limb_count;
+        bool ok = detail::literal_valid(digits, len) && detail::from_literal(x.limbs(), n, digits, len);
+        if(ok && x.limbs()[n - 1] >> (detail::limb_bits - 1)){
+            // only -2^(N-1) has the top bit set
+            ok = negative && x.limbs()[n - 1] == detail::limb(1) << (detail::limb_bits - 1);
+            for(std::size_t i = 0; i + 1 < n; ++i)
+                ok = ok && !x.limbs()[i];
+        }
+        if(!ok)
+            detail::literal_error();
+        if(negative)
+            detail::negate(x.limbs(), n);
+        return x;
+    }
+
+    inline namespace literals{
+        /**
+         * 1234_bi, parsed at compile time into a BigInt with one bit
+         * more than _bu would use, negate it with a leading minus
+         */
+        template<char... Cs>
+        constexpr auto operator""_bi()noexcept{
+            static_assert(detail::literal_valid(detail::literal_chars<Cs...>, sizeof...(Cs)),
+                          "Big::operator\"\"_bi: not an integer literal");
+            constexpr std::size_t N = detail::literal_bits(detail::literal_chars<Cs...>, sizeof...(Cs), 1);
+            constexpr BigInt<N> x = detail::literal_value<BigInt<N>, Cs...>();
+            return x;
+        }
+    }
 };
 
+namespace std{
+    template<std::size_t N>
+    struct hash<Big::BigInt<N>>{
+        std::size_t operator()(const Big::BigInt<N>& x)const noexcept{
+            return Big::detail::hash(x.limbs(), Big::BigInt<N>::limb_count);
+        }
+    };
+}
+
 #endif /* BIGINT_BIGINT_HPP */
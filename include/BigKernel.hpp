@@ -0,0 +1,959 @@
+/**
+ * @file   BigInt/include/BigKernel.hpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Library for representing big integers
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BIGINT_BIGKERNEL_HPP
+#define BIGINT_BIGKERNEL_HPP
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "BigStats.hpp"
+
+/**
+ * keeps the larger kernels out of line, they are called from many
+ * inlined operators and inlining them only grows the code until the
+ * inliner gives up and -Winline reports every remaining call
+ */
+#if defined(__GNUC__)
+#define BIG_NOINLINE __attribute__((noinline))
+#else
+#define BIG_NOINLINE
+#endif
+
+namespace Big{
+    /**
+     * limb level kernels shared by BigUint and BigInt
+     *
+     * all numbers are little endian arrays of limbs, the kernels
+     * never allocate so they stay usable in constant expressions.
+     */
+    namespace detail{
+        using limb  = unsigned int;
+        using dlimb = unsigned long long;
+
+        constexpr std::size_t limb_bits = sizeof(limb) * CHAR_BIT;
+
+        static_assert(sizeof(dlimb) * CHAR_BIT >= 2 * limb_bits,
+                      "Big::detail: dlimb must be able to hold a limb product");
+
+        constexpr void zero(limb* r, std::size_t n)noexcept{
+            for(std::size_t i = 0; i < n; ++i)
+                r[i] = 0;
+        }
+
+        // r may alias a as long as r <= a
+        constexpr void copy(limb* r, const limb* a, std::size_t n)noexcept{
+            for(std::size_t i = 0; i < n; ++i)
+                r[i] = a[i];
+        }
+
+        // number of limbs without the leading zero limbs
+        constexpr std::size_t size(const limb* a, std::size_t n)noexcept{
+            while(n && !a[n - 1])
+                --n;
+            return n;
+        }
+
+        constexpr unsigned clz(limb x)noexcept{
+            if(!x)
+                return limb_bits;
+            unsigned n = 0;
+            for(unsigned s = limb_bits / 2; s; s /= 2){
+                if(!(x >> (limb_bits - s))){
+                    n += s;
+                    x <<= s;
+                }
+            }
+            return n;
+        }
+
+        constexpr unsigned ctz(limb x)noexcept{
+            if(!x)
+                return limb_bits;
+            unsigned n = 0;
+            for(unsigned s = limb_bits / 2; s; s /= 2){
+                if(!(x << (limb_bits - s))){
+                    n += s;
+                    x >>= s;
+                }
+            }
+            return n;
+        }
+
+        constexpr std::size_t bit_length(const limb* a, std::size_t n)noexcept{
+            n = size(a, n);
+            return n ? n * limb_bits - clz(a[n - 1]) : 0;
+        }
+
+        constexpr int cmp(const limb* a, const limb* b, std::size_t n)noexcept{
+            while(n--){
+                if(a[n] != b[n])
+                    return a[n] < b[n] ? -1 : 1;
+            }
+            return 0;
+        }
+
+        // r = a + b, returns the carry
+        constexpr limb add_n(limb* r, const limb* a, const limb* b, std::size_t n)noexcept{
+            BIG_STATS_ADD(add_limbs, n);
+            limb carry = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                dlimb t = dlimb(a[i]) + b[i] + carry;
+                r[i] = limb(t);
+                carry = limb(t >> limb_bits);
+            }
+            return carry;
+        }
+
+        // r = a + b, returns the carry
+        constexpr limb add_1(limb* r, const limb* a, std::size_t n, limb b)noexcept{
+            BIG_STATS_ADD(add_limbs, n);
+            for(std::size_t i = 0; i < n; ++i){
+                limb t = a[i] + b;
+                b = t < b;
+                r[i] = t;
+            }
+            return b;
+        }
+
+        // r = a - b, returns the borrow
+        constexpr limb sub_n(limb* r, const limb* a, const limb* b, std::size_t n)noexcept{
+            BIG_STATS_ADD(add_limbs, n);
+            limb borrow = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                dlimb t = dlimb(a[i]) - b[i] - borrow;
+                r[i] = limb(t);
+                borrow = limb(t >> limb_bits) & 1;
+            }
+            return borrow;
+        }
+
+        // r = a - b, returns the borrow
+        constexpr limb sub_1(limb* r, const limb* a, std::size_t n, limb b)noexcept{
+            BIG_STATS_ADD(add_limbs, n);
+            for(std::size_t i = 0; i < n; ++i){
+                limb t = a[i];
+                r[i] = t - b;
+                b = t < b;
+            }
+            return b;
+        }
+
+        // a = -a in two's complement
+        constexpr void negate(limb* a, std::size_t n)noexcept{
+            limb carry = 1;
+            for(std::size_t i = 0; i < n; ++i){
+                limb t = ~a[i] + carry;
+                carry = t < carry;
+                a[i] = t;
+            }
+        }
+
+        // r = a * b, returns the high limb
+        constexpr limb mul_1(limb* r, const limb* a, std::size_t n, limb b)noexcept{
+            BIG_STATS_ADD(mul_limbs, n);
+            limb carry = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                dlimb t = dlimb(a[i]) * b + carry;
+                r[i] = limb(t);
+                carry = limb(t >> limb_bits);
+            }
+            return carry;
+        }
+
+        // r += a * b, returns the high limb
+        constexpr limb addmul_1(limb* r, const limb* a, std::size_t n, limb b)noexcept{
+            BIG_STATS_ADD(mul_limbs, n);
+            limb carry = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                dlimb t = dlimb(a[i]) * b + r[i] + carry;
+                r[i] = limb(t);
+                carry = limb(t >> limb_bits);
+            }
+            return carry;
+        }
+
+        // r -= a * b, returns the high limb of the borrow
+        constexpr limb submul_1(limb* r, const limb* a, std::size_t n, limb b)noexcept{
+            BIG_STATS_ADD(mul_limbs, n);
+            limb borrow = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                dlimb t = dlimb(a[i]) * b + borrow;
+                limb lo = limb(t);
+                borrow = limb(t >> limb_bits);
+                limb x = r[i];
+                r[i] = x - lo;
+                borrow += x < lo;
+            }
+            return borrow;
+        }
+
+        // r[0, an + bn) = a * b, r must not alias a or b
+        BIG_NOINLINE constexpr void mul(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn)noexcept{
+            BIG_STATS_ADD(mul_schoolbook, 1);
+            zero(r, an);
+            for(std::size_t j = 0; j < bn; ++j)
+                r[an + j] = b[j] ? addmul_1(r + j, a, an, b[j]) : 0;
+        }
+
+        // r[0, rn) += a * b modulo 2^(rn * limb_bits), returns non zero if the sum wrapped
+        BIG_NOINLINE constexpr limb addmul(limb* r, std::size_t rn, const limb* a, std::size_t an,
+                                           const limb* b, std::size_t bn)noexcept{
+            limb out = 0;
+            for(std::size_t j = 0; j < bn && j < rn; ++j){
+                if(!b[j])
+                    continue;
+                const std::size_t len = an < rn - j ? an : rn - j;
+                const limb carry = addmul_1(r + j, a, len, b[j]);
+                if(j + len < rn)
+                    out |= add_1(r + j + len, r + j + len, rn - j - len, carry);
+                else
+                    out |= carry;
+            }
+            return out;
+        }
+
+        // r = |a - b| for an m limb a and an h <= m limb b, returns a < b
+        constexpr bool abs_diff(limb* r, const limb* a, std::size_t m, const limb* b, std::size_t h)noexcept{
+            const bool less = !size(a + h, m - h) && cmp(a, b, h) < 0;
+            if(less){
+                sub_n(r, b, a, h);
+                zero(r + h, m - h);
+            }else{
+                sub_1(r + h, a + h, m - h, sub_n(r, a, b, h));
+            }
+            return less;
+        }
+
+        constexpr std::size_t karatsuba_threshold = 16;
+
+        // scratch space needed by mul_karatsuba and mul_fast for n limb blocks
+        constexpr std::size_t karatsuba_scratch(std::size_t n)noexcept{
+            return 16 * n + 128;
+        }
+
+        /**
+         * r[0, 2n) = a * b for n limb operands by Karatsuba's method
+         *   a * b = z2 * B^2m + (z0 + z2 - (a0 - a1) * (b0 - b1)) * B^m + z0
+         * t is scratch space of karatsuba_scratch(n) limbs
+         */
+        BIG_NOINLINE constexpr void mul_karatsuba(limb* r, const limb* a, const limb* b, std::size_t n, limb* t)noexcept{
+            if(n < karatsuba_threshold){
+                mul(r, a, n, b, n);
+                return;
+            }
+            BIG_STATS_ADD(mul_karatsuba, 1);
+
+            const std::size_t m = (n + 1) / 2;
+            const std::size_t h = n - m;
+            limb* da = t;
+            limb* db = t + m;
+            limb* d = t + 2 * m;
+            limb* next = t + 4 * m;
+
+            const bool negative = abs_diff(da, a, m, a + m, h) != abs_diff(db, b, m, b + m, h);
+            mul_karatsuba(r, a, b, m, next);
+            mul_karatsuba(r + 2 * m, a + m, b + m, h, next);
+            mul_karatsuba(d, da, db, m, next);
+
+            // the middle term is non negative and fits into 2m + 1 limbs
+            limb* mid = next;
+            copy(mid, r, 2 * m);
+            mid[2 * m] = 0;
+            add_1(mid + 2 * h, mid + 2 * h, 2 * (m - h) + 1, add_n(mid, mid, r + 2 * m, 2 * h));
+            if(negative)
+                mid[2 * m] += add_n(mid, mid, d, 2 * m);
+            else
+                mid[2 * m] -= sub_n(mid, mid, d, 2 * m);
+
+            const limb carry = add_n(r + m, r + m, mid, 2 * m + 1);
+            add_1(r + 3 * m + 1, r + 3 * m + 1, 2 * n - 3 * m - 1, carry);
+        }
+
+        /**
+         * r[0, an + bn) = a * b for an >= bn, Karatsuba on bn limb blocks of a
+         * t is scratch space of karatsuba_scratch(bn) limbs
+         */
+        BIG_NOINLINE constexpr void mul_fast(limb* r, const limb* a, std::size_t an, const limb* b, std::size_t bn, limb* t)noexcept{
+            if(bn < karatsuba_threshold){
+                mul(r, a, an, b, bn);
+                return;
+            }
+            BIG_STATS_ADD(mul_unbalanced, 1);
+
+            limb* p = t;
+            limb* s = t + 2 * bn;
+            zero(r, an + bn);
+            for(std::size_t i = 0; i < an; i += bn){
+                const std::size_t len = an - i < bn ? an - i : bn;
+                if(len == bn)
+                    mul_karatsuba(p, a + i, b, bn, s);
+                else
+                    mul_fast(p, b, bn, a + i, len, s);
+                const limb carry = add_n(r + i, r + i, p, len + bn);
+                add_1(r + i + len + bn, r + i + len + bn, an - i - len, carry);
+            }
+        }
+
+        // r = a * b mod 2^(n * limb_bits), r must not alias a or b
+        BIG_NOINLINE constexpr void mul_lo(limb* r, const limb* a, const limb* b, std::size_t n)noexcept{
+            BIG_STATS_ADD(mul_schoolbook, 1);
+            zero(r, n);
+            const std::size_t an = size(a, n);
+            const std::size_t bn = size(b, n);
+            for(std::size_t i = 0; i < an; ++i){
+                if(!a[i])
+                    continue;
+                const std::size_t len = bn < n - i ? bn : n - i;
+                limb carry = addmul_1(r + i, b, len, a[i]);
+                if(i + len < n)
+                    r[i + len] = carry;
+            }
+        }
+
+        /**
+         * r = a * b mod 2^(n * limb_bits), r must not alias a or b
+         *
+         * Karatsuba once both operands have karatsuba_threshold limbs,
+         * a truncated product only saves half of the schoolbook work so
+         * it needs eight times as many
+         */
+        template<std::size_t n>
+        BIG_NOINLINE constexpr void mul_n(limb* r, const limb* a, const limb* b)noexcept{
+            if constexpr(n >= karatsuba_threshold){
+                std::size_t an = size(a, n);
+                std::size_t bn = size(b, n);
+                if(an < bn){
+                    const limb* t = a;
+                    a = b;
+                    b = t;
+                    const std::size_t tn = an;
+                    an = bn;
+                    bn = tn;
+                }
+                if(bn >= karatsuba_threshold && (an + bn <= n || bn >= 8 * karatsuba_threshold)){
+                    std::array<limb, 2 * n + karatsuba_scratch(n)> t{};
+                    mul_fast(t.data(), a, an, b, bn, t.data() + an + bn);
+                    const std::size_t rn = an + bn < n ? an + bn : n;
+                    copy(r, t.data(), rn);
+                    zero(r + rn, n - rn);
+                    return;
+                }
+            }
+            mul_lo(r, a, b, n);
+        }
+
+        // -m^-1 mod 2^limb_bits for an odd m, by newton iteration
+        constexpr limb mont_inverse(limb m)noexcept{
+            limb x = m;
+            for(int i = 0; i < 5; ++i)
+                x *= 2 - m * x;
+            return limb(0) - x;
+        }
+
+        /**
+         * Montgomery multiplication r = a * b / 2^(n * limb_bits) mod m
+         *
+         * requires a, b < m, an odd m and inv = mont_inverse(m[0]),
+         * t is scratch space of n + 2 limbs, r may alias a or b
+         */
+        BIG_NOINLINE constexpr void mont_mul(limb* r, const limb* a, const limb* b, const limb* m, std::size_t n,
+                                             limb inv, limb* t)noexcept{
+            BIG_STATS_ADD(mont_mul, 1);
+            zero(t, n + 2);
+            for(std::size_t i = 0; i < n; ++i){
+                dlimb s = dlimb(t[n]) + addmul_1(t, a, n, b[i]);
+                t[n] = limb(s);
+                t[n + 1] = limb(s >> limb_bits);
+
+                // t = (t + u * m) / 2^limb_bits, the low limb cancels
+                const limb u = t[0] * inv;
+                dlimb c = (dlimb(m[0]) * u + t[0]) >> limb_bits;
+                for(std::size_t j = 1; j < n; ++j){
+                    c += dlimb(m[j]) * u + t[j];
+                    t[j - 1] = limb(c);
+                    c >>= limb_bits;
+                }
+                c += t[n];
+                t[n - 1] = limb(c);
+                t[n] = t[n + 1] + limb(c >> limb_bits);
+                t[n + 1] = 0;
+            }
+            if(t[n] || cmp(t, m, n) >= 0)
+                sub_n(t, t, m, n);
+            copy(r, t, n);
+        }
+
+        // r = a << s for 0 < s < limb_bits, returns the bits shifted out, r >= a
+        constexpr limb lshift(limb* r, const limb* a, std::size_t n, unsigned s)noexcept{
+            BIG_STATS_ADD(shift_limbs, n);
+            limb out = 0;
+            for(std::size_t i = n; i-- > 0;){
+                limb t = a[i];
+                r[i] = t << s;
+                if(i + 1 < n)
+                    r[i + 1] |= t >> (limb_bits - s);
+                else
+                    out = t >> (limb_bits - s);
+            }
+            return out;
+        }
+
+        // r = a >> s for 0 < s < limb_bits, returns the bits shifted out, r <= a
+        constexpr limb rshift(limb* r, const limb* a, std::size_t n, unsigned s)noexcept{
+            BIG_STATS_ADD(shift_limbs, n);
+            limb out = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                limb t = a[i];
+                r[i] = t >> s;
+                if(i)
+                    r[i - 1] |= t << (limb_bits - s);
+                else
+                    out = t << (limb_bits - s);
+            }
+            return out;
+        }
+
+        // a <<= s for arbitrary s within a fixed width array
+        BIG_NOINLINE constexpr void shl(limb* a, std::size_t n, std::size_t s)noexcept{
+            const std::size_t l = s / limb_bits;
+            const unsigned b = unsigned(s % limb_bits);
+            if(l >= n){
+                zero(a, n);
+                return;
+            }
+            if(l){
+                for(std::size_t i = n; i-- > l;)
+                    a[i] = a[i - l];
+                zero(a, l);
+            }
+            if(b)
+                lshift(a + l, a + l, n - l, b);
+        }
+
+        // a >>= s for arbitrary s within a fixed width array, fill is shifted in
+        BIG_NOINLINE constexpr void shr(limb* a, std::size_t n, std::size_t s, limb fill = 0)noexcept{
+            const std::size_t l = s / limb_bits;
+            const unsigned b = unsigned(s % limb_bits);
+            if(l >= n){
+                for(std::size_t i = 0; i < n; ++i)
+                    a[i] = fill;
+                return;
+            }
+            if(l){
+                copy(a, a + l, n - l);
+                for(std::size_t i = n - l; i < n; ++i)
+                    a[i] = fill;
+            }
+            if(b){
+                rshift(a, a, n - l, b);
+                a[n - l - 1] |= fill << (limb_bits - b);
+            }
+        }
+
+        // q = a / d, returns a % d, q may alias a
+        constexpr limb divrem_1(limb* q, const limb* a, std::size_t n, limb d)noexcept{
+            BIG_STATS_ADD(div_1, 1);
+            BIG_STATS_ADD(div_limbs, n);
+            dlimb rem = 0;
+            for(std::size_t i = n; i-- > 0;){
+                dlimb t = (rem << limb_bits) | a[i];
+                q[i] = limb(t / d);
+                rem = t % d;
+            }
+            return limb(rem);
+        }
+
+        // floor((b^2 - 1) / d) - b for a normalized d, b = 2^limb_bits
+        constexpr limb reciprocal(limb d)noexcept{
+            return limb(~dlimb(0) / d);
+        }
+
+        /**
+         * (u1 * b + u0) % d for a normalized d with u1 < d using the
+         * precomputed reciprocal v, Möller and Granlund's 2 by 1 division
+         */
+        constexpr limb rem_2by1(limb u1, limb u0, limb d, limb v)noexcept{
+            const dlimb q = dlimb(v) * u1 + ((dlimb(u1) << limb_bits) | u0);
+            const limb q1 = limb(q >> limb_bits) + 1;
+            limb r = u0 - q1 * d;
+            if(r > limb(q))
+                r += d;
+            if(r >= d)
+                r -= d;
+            return r;
+        }
+
+        // returns a % d, multiplies by a reciprocal instead of dividing every limb
+        constexpr limb mod_1(const limb* a, std::size_t n, limb d)noexcept{
+            BIG_STATS_ADD(div_1, 1);
+            BIG_STATS_ADD(div_limbs, n);
+            if(!n)
+                return 0;
+            const unsigned s = clz(d);
+            const limb dn = d << s;
+            const limb v = reciprocal(dn);
+            limb r = 0;
+            if(s){
+                r = a[n - 1] >> (limb_bits - s);
+                for(std::size_t i = n; i-- > 0;)
+                    r = rem_2by1(r, (a[i] << s) | (i ? a[i - 1] >> (limb_bits - s) : 0), dn, v);
+            }else{
+                for(std::size_t i = n; i-- > 0;)
+                    r = rem_2by1(r, a[i], dn, v);
+            }
+            return r >> s;
+        }
+
+        /**
+         * Knuth algorithm D
+         *
+         * q[0, an - bn] = a / b, r[0, bn) = a % b
+         * requires an >= bn >= 2 and b[bn - 1] != 0
+         * un (an + 1 limbs) and vn (bn limbs) are scratch space
+         */
+        BIG_NOINLINE constexpr void divrem(limb* q, limb* r, const limb* a, std::size_t an,
+                                           const limb* b, std::size_t bn, limb* un, limb* vn)noexcept{
+            BIG_STATS_ADD(div_knuth, 1);
+            BIG_STATS_ADD(div_limbs, an);
+            const unsigned s = clz(b[bn - 1]);
+            copy(vn, b, bn);
+            copy(un, a, an);
+            un[an] = 0;
+            if(s){
+                lshift(vn, vn, bn, s);
+                un[an] = lshift(un, un, an, s);
+            }
+
+            const dlimb base = dlimb(1) << limb_bits;
+            for(std::size_t j = an - bn + 1; j-- > 0;){
+                const dlimb num = (dlimb(un[j + bn]) << limb_bits) | un[j + bn - 1];
+                dlimb qhat = num / vn[bn - 1];
+                dlimb rhat = num % vn[bn - 1];
+                while(qhat >= base || qhat * vn[bn - 2] > ((rhat << limb_bits) | un[j + bn - 2])){
+                    --qhat;
+                    rhat += vn[bn - 1];
+                    if(rhat >= base)
+                        break;
+                }
+
+                const limb borrow = submul_1(un + j, vn, bn, limb(qhat));
+                const limb top = un[j + bn];
+                un[j + bn] = top - borrow;
+                if(top < borrow){
+                    --qhat;
+                    un[j + bn] += add_n(un + j, un + j, vn, bn);
+                }
+                if(q)
+                    q[j] = limb(qhat);
+            }
+
+            if(r){
+                if(s)
+                    rshift(un, un, bn + 1, s);
+                copy(r, un, bn);
+            }
+        }
+
+        /**
+         * q = a / b, r = a % b on n limb numbers, either output may be null
+         *
+         * division by zero yields q = ~0 and r = a
+         * un (n + 1 limbs) and vn (n limbs) are scratch space
+         */
+        BIG_NOINLINE constexpr void divmod(limb* q, limb* r, const limb* a, const limb* b, std::size_t n,
+                                           limb* un, limb* vn)noexcept{
+            const std::size_t an = size(a, n);
+            const std::size_t bn = size(b, n);
+            if(!bn){
+                if(q)
+                    for(std::size_t i = 0; i < n; ++i)
+                        q[i] = ~limb(0);
+                if(r)
+                    copy(r, a, n);
+                return;
+            }
+            if(an < bn || (an == bn && cmp(a, b, an) < 0)){
+                if(r)
+                    copy(r, a, n);
+                if(q)
+                    zero(q, n);
+                return;
+            }
+            if(bn == 1){
+                limb rem = 0;
+                if(q){
+                    copy(un, a, n);
+                    rem = divrem_1(un, un, an, b[0]);
+                    copy(q, un, an);
+                    zero(q + an, n - an);
+                }else{
+                    copy(un, a, an);
+                    rem = divrem_1(un, un, an, b[0]);
+                }
+                if(r){
+                    zero(r, n);
+                    r[0] = rem;
+                }
+                return;
+            }
+            if(q)
+                zero(q, n);
+            if(r)
+                zero(r, n);
+            divrem(q, r, a, an, b, bn, un, vn);
+        }
+
+        // number of trailing zero bits of a non zero number
+        constexpr std::size_t trailing_zeros(const limb* a)noexcept{
+            std::size_t i = 0;
+            while(!a[i])
+                ++i;
+            return i * limb_bits + ctz(a[i]);
+        }
+
+        /**
+         * r = gcd(a, b) by the binary algorithm, a and b are clobbered
+         *
+         * only the limbs still in use are touched, so the cost shrinks
+         * together with the operands
+         */
+        BIG_NOINLINE constexpr void gcd(limb* r, limb* a, limb* b, std::size_t n)noexcept{
+            BIG_STATS_ADD(gcd_binary, 1);
+            std::size_t an = size(a, n);
+            std::size_t bn = size(b, n);
+            zero(r, n);
+            if(!an || !bn){
+                copy(r, an ? a : b, an ? an : bn);
+                return;
+            }
+
+            const std::size_t za = trailing_zeros(a);
+            const std::size_t zb = trailing_zeros(b);
+            shr(a, an, za);
+            shr(b, bn, zb);
+            an = size(a, an);
+            bn = size(b, bn);
+
+            for(;;){
+                int c = an != bn ? (an < bn ? -1 : 1) : cmp(a, b, an);
+                if(!c)
+                    break;
+                if(c < 0){
+                    limb* t = a;
+                    a = b;
+                    b = t;
+                    const std::size_t tn = an;
+                    an = bn;
+                    bn = tn;
+                }
+
+                // both are odd, so a - b is even and non zero
+                const limb borrow = sub_n(a, a, b, bn);
+                sub_1(a + bn, a + bn, an - bn, borrow);
+                an = size(a, an);
+                shr(a, an, trailing_zeros(a));
+                an = size(a, an);
+            }
+
+            copy(r, a, an);
+            shl(r, n, za < zb ? za : zb);
+        }
+
+        // byte i of a, counted from the least significant one
+        constexpr unsigned char get_byte(const limb* a, std::size_t i)noexcept{
+            return static_cast<unsigned char>(a[i / sizeof(limb)] >> (i % sizeof(limb) * CHAR_BIT));
+        }
+
+        // writes the low size bytes of a to out, most significant first if big
+        BIG_NOINLINE constexpr void export_bytes(unsigned char* out, const limb* a, std::size_t n,
+                                                 std::size_t size, bool big)noexcept{
+            const std::size_t have = n * sizeof(limb);
+            for(std::size_t i = 0; i < size; ++i){
+                const unsigned char c = i < have ? get_byte(a, i) : 0;
+                out[big ? size - 1 - i : i] = c;
+            }
+        }
+
+        /**
+         * reads size bytes from in into a, the bytes above size are set
+         * to fill, returns false if a byte that does not fit differs
+         * from fill
+         */
+        BIG_NOINLINE constexpr bool import_bytes(limb* a, std::size_t n, const unsigned char* in,
+                                                 std::size_t size, bool big, unsigned char fill = 0)noexcept{
+            const std::size_t have = n * sizeof(limb);
+            bool fits = true;
+            zero(a, n);
+            for(std::size_t i = 0; i < have; ++i){
+                const unsigned char c = i < size ? in[big ? size - 1 - i : i] : fill;
+                a[i / sizeof(limb)] |= limb(c) << (i % sizeof(limb) * CHAR_BIT);
+            }
+            for(std::size_t i = have; i < size; ++i)
+                if(in[big ? size - 1 - i : i] != fill)
+                    fits = false;
+            return fits;
+        }
+
+        // hash of the value in a, leading zero limbs do not change it
+        BIG_NOINLINE constexpr std::size_t hash(const limb* a, std::size_t n)noexcept{
+            n = size(a, n);
+            dlimb h = n;
+            for(std::size_t i = 0; i < n; ++i){
+                h = (h ^ a[i]) * 0x9e3779b97f4a7c15ull;
+                h ^= h >> 29;
+            }
+            return static_cast<std::size_t>(h);
+        }
+
+        /**
+         * converts a non negative floating point value into limbs,
+         * truncating towards zero and modulo 2^(n * limb_bits)
+         */
+        template<class T>
+        constexpr void from_floating(limb* r, std::size_t n, T x)noexcept{
+            zero(r, n);
+            if(!(x >= T(1)))
+                return;
+            const T base = T(dlimb(1) << limb_bits);
+            std::size_t top = 0;
+            while(x >= base){
+                x /= base;
+                ++top;
+            }
+            for(std::size_t i = top + 1; i-- > 0;){
+                limb l = limb(x);
+                if(i < n)
+                    r[i] = l;
+                x = (x - T(l)) * base;
+            }
+        }
+
+        // largest power of base that fits into a limb and its number of digits
+        constexpr limb chunk_base(unsigned base, unsigned& digits)noexcept{
+            limb big = base;
+            digits = 1;
+            while(dlimb(big) * base <= dlimb(~limb(0))){
+                big *= base;
+                ++digits;
+            }
+            return big;
+        }
+
+        /**
+         * formats the magnitude in a (destroyed) according to the
+         * basefield, uppercase and showbase flags
+         */
+        BIG_NOINLINE inline std::string to_string(limb* a, std::size_t n, std::ios_base::fmtflags flags){
+            const std::ios_base::fmtflags field = flags & std::ios_base::basefield;
+            const unsigned base = field == std::ios_base::hex ? 16 : field == std::ios_base::oct ? 8 : 10;
+            const char* digits = (flags & std::ios_base::uppercase) ? "0123456789ABCDEF" : "0123456789abcdef";
+
+            unsigned chunk_digits = 0;
+            const limb chunk = chunk_base(base, chunk_digits);
+
+            std::string s;
+            n = size(a, n);
+            while(n){
+                limb rem = divrem_1(a, a, n, chunk);
+                n = size(a, n);
+                for(unsigned i = 0; i < chunk_digits && (n || rem); ++i){
+                    s.push_back(digits[rem % base]);
+                    rem /= base;
+                }
+            }
+            if(s.empty())
+                s.push_back('0');
+            if(flags & std::ios_base::showbase){
+                if(base == 16)
+                    s += (flags & std::ios_base::uppercase) ? "X0" : "x0";
+                else if(base == 8 && s != "0")
+                    s.push_back('0');
+            }
+            return std::string(s.rbegin(), s.rend());
+        }
+
+        constexpr int digit_value(int c, unsigned base)noexcept{
+            int d = int(base);
+            if(c >= '0' && c <= '9')
+                d = c - '0';
+            else if(c >= 'a' && c <= 'z')
+                d = c - 'a' + 10;
+            else if(c >= 'A' && c <= 'Z')
+                d = c - 'A' + 10;
+            return d < int(base) ? d : -1;
+        }
+
+        /**
+         * reads digits in the base selected by the stream flags into a,
+         * modulo 2^(n * limb_bits), returns false if no digit was read
+         */
+        BIG_NOINLINE inline bool from_stream(std::istream& is, limb* a, std::size_t n){
+            const std::ios_base::fmtflags field = is.flags() & std::ios_base::basefield;
+            const unsigned base = field == std::ios_base::hex ? 16 : field == std::ios_base::oct ? 8 : 10;
+
+            unsigned chunk_digits = 0;
+            chunk_base(base, chunk_digits);
+
+            zero(a, n);
+            bool any = false;
+            limb value = 0;
+            limb scale = 1;
+            unsigned count = 0;
+            for(int c = is.peek(); c != std::istream::traits_type::eof(); c = is.peek()){
+                const int d = digit_value(c, base);
+                if(d < 0)
+                    break;
+                is.get();
+                any = true;
+                value = value * base + limb(d);
+                scale *= base;
+                if(++count == chunk_digits){
+                    mul_1(a, a, n, scale);
+                    add_1(a, a, n, value);
+                    value = 0;
+                    scale = 1;
+                    count = 0;
+                }
+            }
+            if(count){
+                mul_1(a, a, n, scale);
+                add_1(a, a, n, value);
+            }
+            return any;
+        }
+
+        // the characters of a literal operator template, with static storage
+        template<char... Cs>
+        constexpr char literal_chars[sizeof...(Cs)] = {Cs...};
+
+        // base of an integer literal, skip is set to the length of its prefix
+        constexpr unsigned literal_base(const char* s, std::size_t len, std::size_t& skip)noexcept{
+            skip = 0;
+            if(len < 2 || s[0] != '0')
+                return 10;
+            skip = 2;
+            if(s[1] == 'x' || s[1] == 'X')
+                return 16;
+            if(s[1] == 'b' || s[1] == 'B')
+                return 2;
+            skip = 1;
+            return 8;
+        }
+
+        // false for floating point literals like 1.5 or 1e9
+        constexpr bool literal_valid(const char* s, std::size_t len)noexcept{
+            std::size_t skip = 0;
+            const unsigned base = literal_base(s, len, skip);
+            for(std::size_t i = skip; i < len; ++i)
+                if(s[i] != '\'' && digit_value(s[i], base) < 0)
+                    return false;
+            return true;
+        }
+
+        /**
+         * bits needed by any integer literal with as many digits as s,
+         * plus extra, rounded up to whole limbs
+         */
+        constexpr std::size_t literal_bits(const char* s, std::size_t len, std::size_t extra = 0)noexcept{
+            std::size_t skip = 0;
+            const unsigned base = literal_base(s, len, skip);
+            std::size_t digits = 0;
+            for(std::size_t i = skip; i < len; ++i)
+                if(s[i] != '\'')
+                    ++digits;
+            // 3.322 > log2(10)
+            std::size_t bits = base == 10 ? (digits * 3322 + 999) / 1000 :
+                base == 16 ? digits * 4 : base == 8 ? digits * 3 : digits;
+            bits += extra;
+            return bits ? (bits + limb_bits - 1) / limb_bits * limb_bits : limb_bits;
+        }
+
+        /**
+         * reads an integer literal with an optional base prefix and digit
+         * separators into a, returns false if it has no digits or did
+         * not fit and was truncated modulo 2^(n * limb_bits)
+         */
+        constexpr bool from_literal(limb* a, std::size_t n, const char* s, std::size_t len)noexcept{
+            std::size_t skip = 0;
+            const unsigned base = literal_base(s, len, skip);
+
+            unsigned chunk_digits = 0;
+            chunk_base(base, chunk_digits);
+
+            zero(a, n);
+            bool any = false;
+            limb out = 0;
+            limb value = 0;
+            limb scale = 1;
+            unsigned count = 0;
+            for(std::size_t i = skip; i < len; ++i){
+                if(s[i] == '\'')
+                    continue;
+                any = true;
+                value = value * base + limb(digit_value(s[i], base));
+                scale *= base;
+                if(++count == chunk_digits){
+                    out |= mul_1(a, a, n, scale);
+                    out |= add_1(a, a, n, value);
+                    value = 0;
+                    scale = 1;
+                    count = 0;
+                }
+            }
+            if(count){
+                out |= mul_1(a, a, n, scale);
+                out |= add_1(a, a, n, value);
+            }
+            return any && !out;
+        }
+
+        /**
+         * deliberately not constexpr, calling it from a constant
+         * expression turns a bad Big::literal into a compile error
+         */
+        inline void literal_error()noexcept{}
+
+        // T parsed from the characters of an integer literal
+        template<class T, char... Cs>
+        constexpr T literal_value()noexcept{
+            T r{};
+            from_literal(r.limbs(), T::limb_count, literal_chars<Cs...>, sizeof...(Cs));
+            return r;
+        }
+    }
+};
+
+#endif /* BIGINT_BIGKERNEL_HPP */
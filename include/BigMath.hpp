@@ -32,6 +32,16 @@
 #ifndef BIGINT_BIGMATH_HPP
 #define BIGINT_BIGMATH_HPP
 
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "BigInt.hpp"
 #include "BigUint.hpp"
 #include "BigFloat.hpp"
@@ -41,6 +51,10 @@ namespace Big{
     template<std::size_t N> BigUint<N> abs(const BigUint<N>& x);
     template<std::size_t p, int b, std::size_t r> BigFloat<p, b, r> abs(const BigFloat<p, b, r>& x);
 
+    /**
+     * arguments of any size are reduced exactly, beyond 2^(2^22) they
+     * yield 0 instead
+     */
     template<std::size_t N> BigInt<N> sin(const BigInt<N>& x);
     template<std::size_t N> BigInt<N> cos(const BigInt<N>& x);
     template<std::size_t N> BigInt<N> tan(const BigInt<N>& x);
@@ -106,6 +120,27 @@ namespace Big{
     template<std::size_t N> BigUint<N> sqrt(const BigUint<N>& x);
     template<std::size_t p, int b, std::size_t r> BigFloat<p, b, r> sqrt(const BigFloat<p, b, r>& x);
 
+    /**
+     * integer roots, truncated towards zero
+     *
+     * sqrtrem also stores x - isqrt(x)^2 in rem, negative arguments of
+     * even roots yield 0
+     */
+    template<std::size_t N> BigInt<N> isqrt(const BigInt<N>& x);
+    template<std::size_t N> BigUint<N> isqrt(const BigUint<N>& x);
+    template<std::size_t N> BigInt<N> sqrtrem(const BigInt<N>& x, BigInt<N>& rem);
+    template<std::size_t N> BigUint<N> sqrtrem(const BigUint<N>& x, BigUint<N>& rem);
+    template<std::size_t N> BigInt<N> iroot(const BigInt<N>& x, unsigned long long k);
+    template<std::size_t N> BigUint<N> iroot(const BigUint<N>& x, unsigned long long k);
+
+    /**
+     * true if x = y^k for some integer y and k >= 2
+     */
+    template<std::size_t N> bool is_perfect_square(const BigInt<N>& x);
+    template<std::size_t N> bool is_perfect_square(const BigUint<N>& x);
+    template<std::size_t N> bool is_perfect_power(const BigInt<N>& x);
+    template<std::size_t N> bool is_perfect_power(const BigUint<N>& x);
+
     template<std::size_t N, class T> BigInt<N> pow(const BigInt<N>& base, const T& exp);
     template<std::size_t N, class T> BigInt<N> pow(const T& base, const BigInt<N>& exp);
     template<std::size_t N> BigInt<N> pow(const BigInt<N>& base, const BigInt<N>& exp);
@@ -115,6 +150,1899 @@ namespace Big{
     template<std::size_t p, int b, std::size_t r, class T> BigFloat<p, b, r> pow(const BigFloat<p, b, r>& base, const T& exp);
     template<std::size_t p, int b, std::size_t r, class T> BigFloat<p, b, r> pow(const T& base, const BigFloat<p, b, r>& exp);
     template<std::size_t p, int b, std::size_t r> BigFloat<p, b, r> pow(const BigFloat<p, b, r>& base, const BigFloat<p, b, r>& exp);
+
+    /**
+     * greatest common divisor, gcd(0, 0) = 0
+     */
+    template<std::size_t N> constexpr BigInt<N> gcd(const BigInt<N>& a, const BigInt<N>& b);
+    template<std::size_t N> constexpr BigUint<N> gcd(const BigUint<N>& a, const BigUint<N>& b);
+
+    /**
+     * base^exp mod m, 0 for m < 2
+     */
+    template<std::size_t N> constexpr BigUint<N> powm(const BigUint<N>& base, const BigUint<N>& exp, const BigUint<N>& m);
+
+    /**
+     * n!, the binomial coefficient, the product of the primes <= n and
+     * the product of count values, modulo 2^N
+     *
+     * n! is a multiple of 2^(n - popcount(n)), which makes it 0 modulo
+     * 2^N long before n reaches 2^32. binomial collects prime powers by
+     * Legendre's formula below 2^32 and divides the odd parts of its
+     * factors modulo 2^N beyond, where its cost grows with k. primorial
+     * sieves the odd numbers up to n in segments.
+     *
+     * the factors are multiplied in balanced product trees, whose upper
+     * levels are spread over up to threads threads
+     */
+    template<std::size_t N> BigUint<N> factorial(unsigned long long n, unsigned threads = 1);
+    template<std::size_t N> BigUint<N> binomial(unsigned long long n, unsigned long long k, unsigned threads = 1);
+    template<std::size_t N> BigUint<N> primorial(unsigned long long n, unsigned threads = 1);
+    template<std::size_t N> BigUint<N> product(const BigUint<N>* values, std::size_t count, unsigned threads = 1);
+
+    /**
+     * mathematical constants, computed once and cached for the highest
+     * precision requested so far
+     */
+    template<class F> F const_pi();
+    template<class F> F const_log2();
+    template<class F> F const_log10();
+    template<class F> F const_e();
+
+    namespace detail{
+        template<class F>
+        struct float_traits;
+
+        template<std::size_t p, int b, std::size_t r>
+        struct float_traits<BigFloat<p, b, r>>{
+            static constexpr long long precision = static_cast<long long>(p);
+
+            template<std::size_t P>
+            using with_precision = BigFloat<P, b, r>;
+
+            // working type for the transcendental functions
+            using guarded = BigFloat<p + 64, b, r>;
+        };
+
+        template<class F>
+        using guarded = typename float_traits<F>::guarded;
+
+        template<class F> F sqrt(const F& x);
+        template<class F> F exp(const F& x);
+        template<class F> F expm1(const F& x);
+        template<class F> F log(const F& x);
+        template<class F> F log1p(const F& x);
+        template<class F> void sincos(const F& x, F& sin, F& cos);
+        template<class F> F atan(const F& x);
+
+        /**
+         * shared, thread safe storage of a constant
+         *
+         * the value is kept at the highest precision computed so far and
+         * truncated for lower precisions, constants evaluated by binary
+         * splitting also keep the series state so a higher precision
+         * only has to sum the missing terms.
+         */
+        struct constant_cache{
+            std::shared_mutex mutex;
+            std::size_t precision = 0;
+            long long exponent = 0;
+            std::vector<limb> value;
+
+            unsigned long long terms = 0;
+            bool p_sign = false;
+            bool t_sign = false;
+            std::vector<limb> P;
+            std::vector<limb> Q;
+            std::vector<limb> T;
+        };
+
+        template<class Constant>
+        constant_cache& cache(){
+            static constant_cache c;
+            return c;
+        }
+
+        template<class F>
+        bool load(const constant_cache& c, F& x){
+            constexpr std::size_t limbs = float_traits<F>::precision / limb_bits;
+            if(static_cast<long long>(c.precision) < float_traits<F>::precision)
+                return false;
+
+            const std::size_t offset = c.value.size() - limbs;
+            BigUint<float_traits<F>::precision> m(0ull);
+            copy(m.limbs(), c.value.data() + offset, limbs);
+            x = ldexp(F(m), c.exponent + static_cast<long long>(offset * limb_bits));
+            return true;
+        }
+
+        template<class F>
+        void store(constant_cache& c, const F& x){
+            const auto& m = x.mantissa();
+            c.value.assign(m.limbs(), m.limbs() + m.limb_count);
+            c.exponent = x.exponent();
+            c.precision = float_traits<F>::precision;
+        }
+
+        template<class Constant, class F>
+        F cached(){
+            constant_cache& c = cache<Constant>();
+            F x(0ull);
+            {
+                std::shared_lock<std::shared_mutex> lock(c.mutex);
+                if(load(c, x))
+                    return x;
+            }
+
+            std::unique_lock<std::shared_mutex> lock(c.mutex);
+            if(!load(c, x)){
+                using G = typename float_traits<F>::template with_precision<float_traits<F>::precision + 32>;
+                store(c, Constant::template compute<G>(c));
+                load(c, x);
+            }
+            return x;
+        }
+
+        template<std::size_t W>
+        struct split_term{
+            BigUint<W> P;
+            BigUint<W> Q;
+            BigUint<W> T;
+            bool p_sign;
+            bool t_sign;
+        };
+
+        // x = a + (negate ? -b : b) on sign magnitude values
+        template<std::size_t W>
+        void add_signed(BigUint<W>& x, bool& sign, const BigUint<W>& y, bool y_sign){
+            if(sign == y_sign){
+                x += y;
+            }else if(y <= x){
+                x -= y;
+            }else{
+                x = y - x;
+                sign = y_sign;
+            }
+            if(!x)
+                sign = false;
+        }
+
+        // merges [a, m) and [m, b) into [a, b)
+        template<std::size_t W>
+        void merge(split_term<W>& l, const split_term<W>& h){
+            l.T *= h.Q;
+            BigUint<W> t(l.P);
+            t *= h.T;
+            add_signed(l.T, l.t_sign, t, l.p_sign != h.t_sign);
+            l.P *= h.P;
+            l.p_sign = l.p_sign != h.p_sign;
+            l.Q *= h.Q;
+        }
+
+        /**
+         * binary splitting of a hypergeometric series
+         *   S = sum a(k) * p(0) ... p(k) / (q(0) ... q(k))
+         * over the terms [a, b), S(a, b) = T / Q
+         */
+        template<std::size_t W, class Series>
+        split_term<W> split(unsigned long long a, unsigned long long b){
+            if(b - a == 1){
+                split_term<W> x{Series::template p<W>(a), Series::template q<W>(a), BigUint<W>(0ull),
+                                Series::negative(a), false};
+                x.T = x.P;
+                x.T *= Series::template a<W>(a);
+                x.t_sign = x.p_sign;
+                return x;
+            }
+            const unsigned long long m = a + (b - a) / 2;
+            split_term<W> l = split<W, Series>(a, m);
+            merge(l, split<W, Series>(m, b));
+            return l;
+        }
+
+        template<std::size_t W>
+        BigUint<W> from_limbs(const std::vector<limb>& v){
+            BigUint<W> x(0ull);
+            copy(x.limbs(), v.data(), v.size() < x.limb_count ? v.size() : x.limb_count);
+            return x;
+        }
+
+        template<std::size_t W>
+        std::vector<limb> to_limbs(const BigUint<W>& x){
+            return std::vector<limb>(x.limbs(), x.limbs() + size(x.limbs(), x.limb_count));
+        }
+
+        /**
+         * extends the series state in c to n terms and returns it
+         */
+        template<std::size_t W, class Series>
+        split_term<W> extend(constant_cache& c, unsigned long long n){
+            if(c.terms >= n)
+                return {from_limbs<W>(c.P), from_limbs<W>(c.Q), from_limbs<W>(c.T), c.p_sign, c.t_sign};
+
+            split_term<W> x = split<W, Series>(c.terms, n);
+            if(c.terms){
+                split_term<W> l{from_limbs<W>(c.P), from_limbs<W>(c.Q), from_limbs<W>(c.T), c.p_sign, c.t_sign};
+                merge(l, x);
+                x = l;
+            }
+            c.terms = n;
+            c.P = to_limbs(x.P);
+            c.Q = to_limbs(x.Q);
+            c.T = to_limbs(x.T);
+            c.p_sign = x.p_sign;
+            c.t_sign = x.t_sign;
+            return x;
+        }
+
+        constexpr std::size_t bits_of(unsigned long long x){
+            std::size_t n = 0;
+            for(; x; x >>= 1)
+                ++n;
+            return n;
+        }
+
+        constexpr std::size_t round_limbs(std::size_t bits){
+            return (bits + limb_bits - 1) / limb_bits * limb_bits;
+        }
+
+        /**
+         * Chudnovsky series
+         *   pi = 426880 * sqrt(10005) * Q / T
+         */
+        struct pi_constant{
+            template<std::size_t W>
+            static BigUint<W> p(unsigned long long k){
+                if(!k)
+                    return BigUint<W>(1ull);
+                return BigUint<W>((6 * k - 5) * (2 * k - 1)) * BigUint<W>(6 * k - 1);
+            }
+
+            template<std::size_t W>
+            static BigUint<W> q(unsigned long long k){
+                if(!k)
+                    return BigUint<W>(1ull);
+                return BigUint<W>(k) * BigUint<W>(k) * BigUint<W>(k) * BigUint<W>(10939058860032000ull);
+            }
+
+            template<std::size_t W>
+            static BigUint<W> a(unsigned long long k){
+                return BigUint<W>(13591409ull) + BigUint<W>(545140134ull) * BigUint<W>(k);
+            }
+
+            static constexpr bool negative(unsigned long long k){
+                return k != 0;
+            }
+
+            static constexpr unsigned long long terms(long long precision){
+                return static_cast<unsigned long long>(precision) / 47 + 2;
+            }
+
+            static constexpr std::size_t width(unsigned long long n){
+                std::size_t bits = 128;
+                for(unsigned long long k = 1; k <= n; ++k)
+                    bits += 6 * bits_of(k) + 61;
+                return round_limbs(bits);
+            }
+
+            template<class F>
+            static F compute(constant_cache& c){
+                constexpr unsigned long long n = terms(float_traits<F>::precision);
+                const auto x = extend<width(n), pi_constant>(c, n);
+                return F(426880ull) * sqrt(F(10005ull)) * F(x.Q) / F(x.T);
+            }
+        };
+
+        /**
+         * e = sum 1 / k!
+         */
+        struct e_constant{
+            template<std::size_t W>
+            static BigUint<W> p(unsigned long long){
+                return BigUint<W>(1ull);
+            }
+
+            template<std::size_t W>
+            static BigUint<W> q(unsigned long long k){
+                return BigUint<W>(k ? k : 1ull);
+            }
+
+            template<std::size_t W>
+            static BigUint<W> a(unsigned long long){
+                return BigUint<W>(1ull);
+            }
+
+            static constexpr bool negative(unsigned long long){
+                return false;
+            }
+
+            // smallest n with n! > 2^(precision + 2)
+            static constexpr unsigned long long terms(long long precision){
+                unsigned long long n = 1;
+                long long bits = 0;
+                while(bits <= precision + 2)
+                    bits += static_cast<long long>(bits_of(++n)) - 1;
+                return n + 1;
+            }
+
+            static constexpr std::size_t width(unsigned long long n){
+                std::size_t bits = 128;
+                for(unsigned long long k = 1; k <= n; ++k)
+                    bits += bits_of(k);
+                return round_limbs(bits);
+            }
+
+            template<class F>
+            static F compute(constant_cache& c){
+                constexpr unsigned long long n = terms(float_traits<F>::precision);
+                const auto x = extend<width(n), e_constant>(c, n);
+                return F(x.T) / F(x.Q);
+            }
+        };
+
+        template<class F>
+        F agm(F a, F b){
+            const long long precision = float_traits<F>::precision;
+            for(int i = 0; i < 64; ++i){
+                const F d = a - b;
+                if(!d.mantissa() || ilogb(d) < ilogb(a) - precision)
+                    break;
+                const F t = ldexp(a + b, -1);
+                b = detail::sqrt(a * b);
+                a = t;
+            }
+            return a;
+        }
+
+        /**
+         * log(2) = 3 / 4 * sum (-1)^k * k!^2 / (2^k * (2k + 1)!)
+         */
+        struct log2_constant{
+            template<std::size_t W>
+            static BigUint<W> p(unsigned long long k){
+                return BigUint<W>(k ? k : 1ull);
+            }
+
+            template<std::size_t W>
+            static BigUint<W> q(unsigned long long k){
+                return BigUint<W>(k ? 8 * k + 4 : 1ull);
+            }
+
+            template<std::size_t W>
+            static BigUint<W> a(unsigned long long){
+                return BigUint<W>(1ull);
+            }
+
+            static constexpr bool negative(unsigned long long k){
+                return k != 0;
+            }
+
+            // every term adds at least 3 bits
+            static constexpr unsigned long long terms(long long precision){
+                return static_cast<unsigned long long>(precision) / 3 + 2;
+            }
+
+            static constexpr std::size_t width(unsigned long long n){
+                std::size_t bits = 128;
+                for(unsigned long long k = 1; k <= n; ++k)
+                    bits += bits_of(k) + bits_of(8 * k + 4);
+                return round_limbs(bits);
+            }
+
+            template<class F>
+            static F compute(constant_cache& c){
+                constexpr unsigned long long n = terms(float_traits<F>::precision);
+                const auto x = extend<width(n), log2_constant>(c, n);
+                return F(3ull) * F(x.T) / ldexp(F(x.Q), 2);
+            }
+        };
+
+        struct log10_constant{
+            template<class F>
+            static F compute(constant_cache&){
+                return detail::log(F(10ull));
+            }
+        };
+
+        // number of halvings before a series is summed
+        template<class F>
+        long long reduction(const F& x, long long target){
+            const long long s = ilogb(x) + 1 + target;
+            return s > 0 ? s : 0;
+        }
+
+        template<class F>
+        long long reduction_target(){
+            return static_cast<long long>(std::sqrt(static_cast<double>(float_traits<F>::precision)));
+        }
+
+        template<std::size_t N>
+        constexpr BigUint<N> magnitude(const BigInt<N>& x){
+            BigUint<N> y(0ull);
+            copy(y.limbs(), x.limbs(), y.limb_count);
+            if(x < BigInt<N>(0ll))
+                negate(y.limbs(), y.limb_count);
+            return y;
+        }
+
+        template<std::size_t N>
+        limb mod_1(const BigUint<N>& x, limb d){
+            return mod_1(x.limbs(), size(x.limbs(), x.limb_count), d);
+        }
+
+        // newton step y -> ((k - 1) * y + x / y^(k - 1)) / k towards floor(x^(1 / k))
+        template<std::size_t N>
+        BigUint<N> root_step(const BigUint<N>& x, const BigUint<N>& y, unsigned long long k){
+            if(k == 2)
+                return (y + x / y) >> 1;
+
+            BigUint<N> q(x);
+            for(unsigned long long i = 1; i < k && q; ++i)
+                q /= y;
+            return (y * BigUint<N>(k - 1) + q) / BigUint<N>(k);
+        }
+
+        // x^(1 / k) from the leading 64 bits, for roots below 2^32
+        template<std::size_t N>
+        BigUint<N> root_seed(const BigUint<N>& x, unsigned long long k){
+            const std::size_t bits = x.bit_length();
+            const std::size_t shift = bits > 64 ? bits - 64 : 0;
+            const double top = static_cast<double>(static_cast<unsigned long long>(x >> shift));
+            const double l = (std::log2(top) + static_cast<double>(shift)) / static_cast<double>(k);
+            return BigUint<N>(static_cast<unsigned long long>(std::exp2(l)) + 1);
+        }
+
+        // y^k > x without overflowing
+        constexpr bool power_exceeds(unsigned long long y, unsigned long long k, unsigned long long x){
+            unsigned long long p = 1;
+            for(; k; --k){
+                if(y && p > x / y)
+                    return true;
+                p *= y;
+            }
+            return p > x;
+        }
+
+        BIG_NOINLINE inline unsigned long long root_1(unsigned long long x, unsigned long long k){
+            if(k == 1 || x < 2)
+                return x;
+            unsigned long long y = static_cast<unsigned long long>(std::pow(static_cast<double>(x), 1.0 / static_cast<double>(k)));
+            while(power_exceeds(y, k, x))
+                --y;
+            while(!power_exceeds(y + 1, k, x))
+                ++y;
+            return y;
+        }
+
+        /**
+         * floor(x^(1 / k)) for k >= 1
+         *
+         * the root of the leading half of x is computed recursively, which
+         * leaves the newton iteration only a step or two at full size
+         */
+        template<std::size_t N>
+        BigUint<N> root(const BigUint<N>& x, unsigned long long k){
+            const std::size_t bits = x.bit_length();
+            if(k == 1)
+                return x;
+            if(bits <= 64)
+                return BigUint<N>(root_1(static_cast<unsigned long long>(x), k));
+            if(bits <= k)
+                return BigUint<N>(1ull);
+
+            // continue in a narrower type once x fits, the fixed width operations stay proportional to x
+            constexpr std::size_t H = N / 2 / limb_bits * limb_bits;
+            if constexpr(H > 64)
+                if(bits + limb_bits <= H)
+                    return BigUint<N>(root(BigUint<H>(x), k));
+
+            BigUint<N> y(0ull);
+            if(bits / k < 32){
+                y = root_seed(x, k);
+            }else{
+                const std::size_t t = bits / (2 * k);
+                y = root(x >> (k * t), k) << t;
+            }
+
+            // any step lands on or above the root, from there it decreases
+            y = root_step(x, y, k);
+            if(k == 2 && 2 * y.bit_length() <= N){
+                // y is at most a few units too large, squaring is cheaper than another step
+                while(x < y * y)
+                    --y;
+                return y;
+            }
+            for(;;){
+                const BigUint<N> z = root_step(x, y, k);
+                if(!(z < y))
+                    return y;
+                y = z;
+            }
+        }
+
+        constexpr unsigned long long square_mask(unsigned long long m){
+            unsigned long long mask = 0;
+            for(unsigned long long i = 0; i < m; ++i)
+                mask |= 1ull << (i * i % m);
+            return mask;
+        }
+
+        constexpr bool is_small_prime(unsigned long long n){
+            if(n < 4)
+                return n > 1;
+            if(!(n & 1))
+                return false;
+            for(unsigned long long d = 3; d * d <= n; d += 2)
+                if(!(n % d))
+                    return false;
+            return true;
+        }
+
+        constexpr unsigned long long powmod_1(unsigned long long a, unsigned long long e, unsigned long long m){
+            unsigned long long y = 1;
+            a %= m;
+            for(; e; e >>= 1){
+                if(e & 1)
+                    y = y * a % m;
+                a = a * a % m;
+            }
+            return y;
+        }
+
+        // quadratic residues modulo 64, 63, 11, 13 and 17 reject all but 0.75% of the non squares
+        template<std::size_t N>
+        bool square_residue(const BigUint<N>& x){
+            constexpr unsigned long long m64 = square_mask(64);
+            constexpr unsigned long long m63 = square_mask(63);
+            constexpr unsigned long long m11 = square_mask(11);
+            constexpr unsigned long long m13 = square_mask(13);
+            constexpr unsigned long long m17 = square_mask(17);
+            if(!((m64 >> (x.limbs()[0] & 63)) & 1))
+                return false;
+            const limb r = mod_1(x, 63 * 11 * 13 * 17);
+            return ((m63 >> (r % 63)) & 1) && ((m11 >> (r % 11)) & 1) &&
+                ((m13 >> (r % 13)) & 1) && ((m17 >> (r % 17)) & 1);
+        }
+
+        // x is a k-th power residue modulo the first primes q = 1 (mod k), for odd primes k
+        template<std::size_t N>
+        bool power_residue(const BigUint<N>& x, unsigned long long k){
+            int tested = 0;
+            for(unsigned long long q = 2 * k + 1; tested < 4 && q < (1ull << 31); q += 2 * k){
+                if(!is_small_prime(q))
+                    continue;
+                ++tested;
+                const limb r = mod_1(x, static_cast<limb>(q));
+                if(r && powmod_1(r, (q - 1) / k, q) != 1)
+                    return false;
+            }
+            return true;
+        }
+
+        template<std::size_t N>
+        bool perfect_power(const BigUint<N>& x, bool odd){
+            const std::size_t bits = x.bit_length();
+            if(bits <= 1)
+                return true;
+
+            // for x = y^k * 2^v, k has to divide v
+            std::size_t v = 0;
+            while(!x.limbs()[v / limb_bits])
+                v += limb_bits;
+            v += ctz(x.limbs()[v / limb_bits]);
+
+            if(!odd && !(v & 1) && square_residue(x)){
+                const BigUint<N> y = root(x, 2);
+                if(y * y == x)
+                    return true;
+            }
+            for(unsigned long long k = 3; k < bits; k += 2){
+                if((v && v % k) || !is_small_prime(k) || !power_residue(x, k))
+                    continue;
+                if(pow_uint(root(x, k), k) == x)
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * arithmetic modulo an odd m > 1 on numbers in Montgomery form
+         * x * R mod m, with R = 2^(n * limb_bits) for the n limbs of m
+         */
+        template<std::size_t N>
+        class montgomery{
+            BigUint<N> m;
+            std::size_t n;
+            limb inv;
+            BigUint<N> r2;
+
+        public:
+            BIG_NOINLINE explicit constexpr montgomery(const BigUint<N>& modulus):
+                m(modulus),
+                n(size(modulus.limbs(), modulus.limb_count)),
+                inv(mont_inverse(modulus.limbs()[0])),
+                r2(0ull){
+                using W = BigUint<2 * N + limb_bits>;
+                r2 = BigUint<N>((W(1ull) << (2 * n * limb_bits)) % W(m));
+            }
+
+            constexpr const BigUint<N>& modulus()const noexcept{
+                return m;
+            }
+
+            constexpr BigUint<N> mul(const BigUint<N>& a, const BigUint<N>& b)const noexcept{
+                std::array<limb, BigUint<N>::limb_count + 2> t{};
+                BigUint<N> r(0ull);
+                mont_mul(r.limbs(), a.limbs(), b.limbs(), m.limbs(), n, inv, t.data());
+                return r;
+            }
+
+            constexpr BigUint<N> one()const noexcept{
+                return mul(r2, BigUint<N>(1ull));
+            }
+
+            constexpr BigUint<N> to(const BigUint<N>& x)const noexcept{
+                return mul(x < m ? x : x % m, r2);
+            }
+
+            constexpr BigUint<N> from(const BigUint<N>& x)const noexcept{
+                return mul(x, BigUint<N>(1ull));
+            }
+
+            // x^e with a fixed window of 4 bits
+            BIG_NOINLINE constexpr BigUint<N> pow(const BigUint<N>& x, const BigUint<N>& e)const noexcept{
+                std::array<BigUint<N>, 16> table{};
+                table[0] = one();
+                for(std::size_t i = 1; i < table.size(); ++i)
+                    table[i] = mul(table[i - 1], x);
+
+                BigUint<N> y(table[0]);
+                const std::size_t windows = (e.bit_length() + 3) / 4;
+                for(std::size_t i = windows; i-- > 0;){
+                    if(i + 1 < windows)
+                        for(int j = 0; j < 4; ++j)
+                            y = mul(y, y);
+                    const limb w = (e.limbs()[4 * i / limb_bits] >> (4 * i % limb_bits)) & 15;
+                    if(w)
+                        y = mul(y, table[w]);
+                }
+                return y;
+            }
+        };
+
+        // base^exp mod m for an even m >= 2, square and multiply at double width
+        template<std::size_t N>
+        BIG_NOINLINE constexpr BigUint<N> powm_even(const BigUint<N>& base, const BigUint<N>& exp, const BigUint<N>& m){
+            using W = BigUint<2 * N>;
+            const W wm(m);
+            const W x(base % m);
+            W y(1ull);
+            for(std::size_t i = exp.bit_length(); i-- > 0;){
+                y = y * y % wm;
+                if((exp.limbs()[i / limb_bits] >> (i % limb_bits)) & 1)
+                    y = y * x % wm;
+            }
+            return BigUint<N>(y);
+        }
+
+        // the primes and prime powers of the product trees are single limbs
+        constexpr unsigned long long max_factor = 1ull << limb_bits;
+
+        // primes <= n for n < max_factor
+        BIG_NOINLINE inline std::vector<limb> primes_up_to(unsigned long long n){
+            std::vector<limb> primes;
+            if(n >= 2)
+                primes.push_back(2);
+            std::vector<bool> composite(static_cast<std::size_t>(n / 2 + 1));
+            for(unsigned long long i = 3; i <= n; i += 2){
+                if(composite[static_cast<std::size_t>(i / 2)])
+                    continue;
+                primes.push_back(static_cast<limb>(i));
+                for(unsigned long long j = i * i; j <= n; j += 2 * i)
+                    composite[static_cast<std::size_t>(j / 2)] = true;
+            }
+            return primes;
+        }
+
+        // a * b truncated to cap limbs, without leading zero limbs
+        BIG_NOINLINE inline std::vector<limb> multiply(const limb* a, std::size_t an, const limb* b, std::size_t bn, std::size_t cap){
+            an = an < cap ? an : cap;
+            bn = bn < cap ? bn : cap;
+            if(an < bn)
+                return multiply(b, bn, a, an, cap);
+            if(!bn)
+                return {};
+
+            std::vector<limb> r(an + bn);
+            std::vector<limb> t(karatsuba_scratch(bn));
+            mul_fast(r.data(), a, an, b, bn, t.data());
+            r.resize(size(r.data(), r.size() < cap ? r.size() : cap));
+            return r;
+        }
+
+        inline std::vector<limb> multiply(const std::vector<limb>& a, const std::vector<limb>& b, std::size_t cap){
+            return multiply(a.data(), a.size(), b.data(), b.size(), cap);
+        }
+
+        /**
+         * product of leaf(first) ... leaf(last - 1) truncated to cap limbs,
+         * leaf(i) is the pair of a limb pointer and the number of limbs
+         *
+         * the halves are evaluated on separate threads while there are
+         * threads to spare
+         */
+        template<class Leaf>
+        std::vector<limb> product_tree(std::size_t first, std::size_t last, std::size_t cap, unsigned threads, const Leaf& leaf){
+            if(last - first <= 16){
+                std::vector<limb> r(1, 1);
+                for(std::size_t i = first; i < last && !r.empty(); ++i){
+                    const auto x = leaf(i);
+                    if(x.second == 1){
+                        const limb carry = mul_1(r.data(), r.data(), r.size(), x.first[0]);
+                        if(carry && r.size() < cap)
+                            r.push_back(carry);
+                        r.resize(size(r.data(), r.size()));
+                    }else{
+                        r = multiply(r.data(), r.size(), x.first, x.second, cap);
+                    }
+                }
+                return r;
+            }
+
+            const std::size_t mid = first + (last - first) / 2;
+            std::vector<limb> low;
+            std::vector<limb> high;
+            if(threads > 1){
+                std::thread t([&]{
+                    low = product_tree(first, mid, cap, threads / 2, leaf);
+                });
+                high = product_tree(mid, last, cap, threads - threads / 2, leaf);
+                t.join();
+            }else{
+                low = product_tree(first, mid, cap, 1, leaf);
+                high = product_tree(mid, last, cap, 1, leaf);
+            }
+            return multiply(low, high, cap);
+        }
+
+        // product of single limb factors
+        inline std::vector<limb> product_tree(const std::vector<limb>& factors, std::size_t cap, unsigned threads){
+            return product_tree(0, factors.size(), cap, threads, [&](std::size_t i){
+                return std::make_pair(factors.data() + i, std::size_t(1));
+            });
+        }
+
+        /**
+         * odd part of the swing n! / (n / 2)!^2, each odd prime p <= n
+         * occurs once for every odd floor(n / p^i)
+         */
+        BIG_NOINLINE inline std::vector<limb> odd_swing(unsigned long long n, const std::vector<limb>& primes, std::size_t cap, unsigned threads){
+            std::vector<limb> factors;
+            for(std::size_t i = 1; i < primes.size() && primes[i] <= n; ++i){
+                const limb p = primes[i];
+                limb f = 1;
+                for(unsigned long long q = n / p; q; q /= p)
+                    if(q & 1)
+                        f *= p;
+                if(f > 1)
+                    factors.push_back(f);
+            }
+            return product_tree(factors, cap, threads);
+        }
+
+        // odd part of n!, n! = odd_factorial(n) * 2^(n - popcount(n))
+        BIG_NOINLINE inline std::vector<limb> odd_factorial(unsigned long long n, const std::vector<limb>& primes, std::size_t cap, unsigned threads){
+            if(n < 3)
+                return std::vector<limb>(1, 1);
+            const std::vector<limb> x = odd_factorial(n / 2, primes, cap, threads);
+            return multiply(multiply(x, x, cap), odd_swing(n, primes, cap, threads), cap);
+        }
+
+        constexpr unsigned popcount(unsigned long long x)noexcept{
+            unsigned ones = 0;
+            for(; x; x &= x - 1)
+                ++ones;
+            return ones;
+        }
+
+        /**
+         * product of factors below 2^64 truncated to cap limbs, the
+         * factors are gathered in blocks and every block goes through a
+         * product tree into the running product, so they never all
+         * exist at once
+         */
+        class block_product{
+            static constexpr std::size_t block = std::size_t(1) << 14;
+
+            std::vector<limb> factors;
+            std::vector<limb> r;
+            std::size_t cap;
+            unsigned threads;
+
+            void flush(){
+                const std::vector<limb> x = product_tree(0, factors.size() / 2, cap, threads, [&](std::size_t i){
+                    const limb* f = factors.data() + 2 * i;
+                    return std::make_pair(f, std::size_t(f[1] ? 2 : 1));
+                });
+                r = multiply(r, x, cap);
+                factors.clear();
+            }
+
+        public:
+            block_product(std::size_t limbs, unsigned count):
+                r(1, 1),
+                cap(limbs),
+                threads(count){}
+
+            // out of line, every unwinding path calls it
+            BIG_NOINLINE ~block_product(){}
+
+            void push(unsigned long long x){
+                factors.push_back(limb(x));
+                factors.push_back(limb(x >> limb_bits));
+                if(factors.size() == 2 * block)
+                    flush();
+            }
+
+            std::vector<limb> result(){
+                flush();
+                return r;
+            }
+        };
+
+        /**
+         * product of the primes <= n truncated to cap limbs, the odd
+         * numbers are sieved in segments by the primes up to sqrt(n)
+         */
+        BIG_NOINLINE inline std::vector<limb> primorial(unsigned long long n, std::size_t cap, unsigned threads){
+            block_product r(cap, threads);
+            if(n < 2)
+                return r.result();
+            r.push(2);
+
+            const std::vector<limb> base = primes_up_to(static_cast<unsigned long long>(isqrt(BigUint<64>(n))));
+            // odd numbers per segment
+            constexpr unsigned long long span = 1ull << 16;
+            std::vector<unsigned char> composite(span);
+            // next odd multiple of every odd base prime in use, relative to lo
+            std::vector<unsigned long long> next;
+            for(unsigned long long lo = 3;; lo += 2 * span){
+                const unsigned long long count = (n - lo) / 2 < span ? (n - lo) / 2 + 1 : span;
+                // offsets are relative to lo, so nothing overflows near 2^64
+                const unsigned long long last = 2 * (count - 1);
+                for(std::size_t i = next.size() + 1; i < base.size(); ++i){
+                    const unsigned long long p = base[i];
+                    if(p * p - lo > last)
+                        break;
+                    next.push_back(p * p - lo);
+                }
+
+                composite.assign(span, 0);
+                for(std::size_t i = 0; i < next.size(); ++i){
+                    const unsigned long long p = base[i + 1];
+                    unsigned long long offset = next[i];
+                    for(; offset <= last; offset += 2 * p)
+                        composite[static_cast<std::size_t>(offset / 2)] = 1;
+                    next[i] = offset - 2 * span;
+                }
+                for(unsigned long long i = 0; i < count; ++i)
+                    if(!composite[static_cast<std::size_t>(i)])
+                        r.push(lo + 2 * i);
+                if(n - lo < 2 * span)
+                    break;
+            }
+            return r.result();
+        }
+
+        /**
+         * odd parts of n! / (n - k)! and of k! truncated to cap limbs,
+         * for the binomial coefficients whose factors are too wide to sieve
+         */
+        BIG_NOINLINE inline std::pair<std::vector<limb>, std::vector<limb>> odd_binomial(unsigned long long n, unsigned long long k,
+                                                                                         std::size_t cap, unsigned threads){
+            block_product above(cap, threads);
+            block_product below(cap, threads);
+            for(unsigned long long i = 1; i <= k; ++i){
+                const unsigned long long a = n - k + i;
+                above.push(a / (a & (0 - a)));
+                below.push(i / (i & (0 - i)));
+            }
+            return {above.result(), below.result()};
+        }
+
+        /**
+         * the mantissa is widened to twice the precision and its integer
+         * square root is the correctly truncated result
+         */
+        template<class F>
+        F sqrt(const F& x){
+            if(x.sign() || !x.mantissa())
+                return F(0ull);
+
+            constexpr std::size_t p = float_traits<F>::precision;
+            const long long e = x.exponent();
+            const long long shift = static_cast<long long>(p) + ((e - static_cast<long long>(p)) & 1);
+            const BigUint<2 * p + 64> m = BigUint<2 * p + 64>(x.mantissa()) << shift;
+            return ldexp(F(root(m, 2)), (e - shift) / 2);
+        }
+
+        // exp(x) - 1 for small x, by halving, a taylor series and doubling
+        template<class F>
+        F expm1_reduced(const F& x){
+            if(!x.mantissa())
+                return x;
+
+            const long long precision = float_traits<F>::precision;
+            const long long s = reduction(x, reduction_target<F>());
+            const F t = ldexp(x, -s);
+            F sum(t);
+            F term(t);
+            for(unsigned long long k = 2; ; ++k){
+                term *= t;
+                term /= F(k);
+                if(!term.mantissa() || ilogb(term) < ilogb(sum) - precision)
+                    break;
+                sum += term;
+            }
+
+            // (1 + u)^2 - 1 = u * (2 + u)
+            const F two(2ull);
+            for(long long i = 0; i < s; ++i)
+                sum *= sum + two;
+            return sum;
+        }
+
+        template<class F>
+        F exp(const F& x){
+            if(!x.mantissa())
+                return F(1ull);
+            if(ilogb(x) > 62)
+                return x.sign() ? F(0ull) : ldexp(F(1ull), std::numeric_limits<long long>::max());
+
+            const F ln2 = cached<log2_constant, F>();
+            const F q = x / ln2;
+            const long long k = static_cast<long long>(q + F(q.sign() ? -0.5 : 0.5));
+            const F y = expm1_reduced(x - F(k) * ln2);
+            return ldexp(y + F(1ull), k);
+        }
+
+        template<class F>
+        F expm1(const F& x){
+            if(!x.mantissa() || ilogb(x) < -1)
+                return expm1_reduced(x);
+            return exp(x) - F(1ull);
+        }
+
+        // log(1 + t) = 2 * atanh(t / (2 + t)) for small t
+        template<class F>
+        F log1p_series(const F& t){
+            const long long precision = float_traits<F>::precision;
+            const F z = t / (t + F(2ull));
+            const F z2 = z * z;
+            F sum(z);
+            F power(z);
+            for(unsigned long long k = 3; ; k += 2){
+                power *= z2;
+                const F term = power / F(k);
+                if(!term.mantissa() || ilogb(term) < ilogb(sum) - precision)
+                    break;
+                sum += term;
+            }
+            return ldexp(sum, 1);
+        }
+
+        /**
+         * log(x) = pi / (2 * AGM(1, 4 / s)) - m * log(2) with s = x * 2^m > 2^(precision / 2)
+         */
+        template<class F>
+        F log(const F& x){
+            if(x.sign() || !x.mantissa())
+                return F(0ull);
+
+            const F t = x - F(1ull);
+            if(!t.mantissa())
+                return t;
+            if(ilogb(t) < -16)
+                return log1p_series(t);
+
+            const long long m = float_traits<F>::precision / 2 + 2 - ilogb(x);
+            const F a = agm(F(1ull), ldexp(F(1ull) / x, 2 - m));
+            return cached<pi_constant, F>() / ldexp(a, 1) - F(m) * cached<log2_constant, F>();
+        }
+
+        template<class F>
+        F log1p(const F& x){
+            if(!x.mantissa() || ilogb(x) < -16)
+                return x.mantissa() ? log1p_series(x) : x;
+            return log(x + F(1ull));
+        }
+
+        // 1 - cos(x) for small x, by halving, a taylor series and doubling
+        template<class F>
+        F versine(const F& x){
+            const long long precision = float_traits<F>::precision;
+            const long long s = reduction(x, reduction_target<F>() / 2);
+            const F t = ldexp(x, -s);
+            const F t2 = t * t;
+            F term = ldexp(t2, -1);
+            F sum(term);
+            for(unsigned long long k = 3; ; k += 2){
+                term *= t2;
+                term /= F(k * (k + 1));
+                -term;
+                if(!term.mantissa() || ilogb(term) < ilogb(sum) - precision)
+                    break;
+                sum += term;
+            }
+
+            // 1 - cos(2x) = 2 * v * (2 - v) with v = 1 - cos(x)
+            const F two(2ull);
+            for(long long i = 0; i < s; ++i)
+                sum = ldexp(sum * (two - sum), 1);
+            return sum;
+        }
+
+        // no truncation for multiply
+        constexpr std::size_t uncapped = ~std::size_t(0);
+
+        // x >>= s on a vector, without leading zero limbs
+        inline void shift_right(std::vector<limb>& x, std::size_t s){
+            shr(x.data(), x.size(), s);
+            x.resize(size(x.data(), x.size()));
+        }
+
+        // x <<= s on a vector, widened to hold the result
+        inline void shift_left(std::vector<limb>& x, std::size_t s){
+            x.resize(x.size() + s / limb_bits + 1, 0);
+            shl(x.data(), x.size(), s);
+            x.resize(size(x.data(), x.size()));
+        }
+
+        // a / b for b != 0, without leading zero limbs
+        BIG_NOINLINE inline std::vector<limb> divide(const std::vector<limb>& a, const std::vector<limb>& b){
+            if(a.size() < b.size())
+                return {};
+            std::vector<limb> q(a.size() - b.size() + 1, 0);
+            if(b.size() == 1){
+                divrem_1(q.data(), a.data(), a.size(), b[0]);
+            }else{
+                std::vector<limb> un(a.size() + 1);
+                std::vector<limb> vn(b.size());
+                divrem(q.data(), nullptr, a.data(), a.size(), b.data(), b.size(), un.data(), vn.data());
+            }
+            q.resize(size(q.data(), q.size()));
+            return q;
+        }
+
+        // x = x + (y_sign ? -y : y) on sign magnitude vectors
+        BIG_NOINLINE inline void add_signed(std::vector<limb>& x, bool& sign, const std::vector<limb>& y, bool y_sign){
+            if(sign == y_sign){
+                if(x.size() < y.size())
+                    x.resize(y.size(), 0);
+                const limb carry = add_n(x.data(), x.data(), y.data(), y.size());
+                if(add_1(x.data() + y.size(), x.data() + y.size(), x.size() - y.size(), carry))
+                    x.push_back(1);
+            }else if(y.size() < x.size() || (y.size() == x.size() && cmp(y.data(), x.data(), y.size()) <= 0)){
+                const limb borrow = sub_n(x.data(), x.data(), y.data(), y.size());
+                sub_1(x.data() + y.size(), x.data() + y.size(), x.size() - y.size(), borrow);
+            }else{
+                std::vector<limb> t(y);
+                const limb borrow = sub_n(t.data(), t.data(), x.data(), x.size());
+                sub_1(t.data() + x.size(), t.data() + x.size(), t.size() - x.size(), borrow);
+                x.swap(t);
+                sign = y_sign;
+            }
+            x.resize(size(x.data(), x.size()));
+            if(x.empty())
+                sign = false;
+        }
+
+        // bits of the quotients below which dividing beats newton's iteration
+        constexpr std::size_t reciprocal_threshold = 64 * limb_bits;
+
+        // the leading k bits of x != 0
+        inline std::vector<limb> leading(const std::vector<limb>& x, std::size_t k){
+            std::vector<limb> y(x);
+            const std::size_t n = bit_length(x.data(), x.size());
+            if(n > k)
+                shift_right(y, n - k);
+            else
+                shift_left(y, k - n);
+            return y;
+        }
+
+        /**
+         * 2^(2 k) / d within a few units, d the leading k bits of b
+         *
+         * one newton step r + r * (2^(2 k) - d * r) / 2^(2 k) from the
+         * reciprocal of the leading half, so the cost is that of a few
+         * multiplications at full size
+         */
+        BIG_NOINLINE inline std::vector<limb> reciprocal(const std::vector<limb>& b, std::size_t k){
+            const std::vector<limb> d = leading(b, k);
+            std::vector<limb> one(1, 1);
+            shift_left(one, 2 * k);
+            if(k <= reciprocal_threshold)
+                return divide(one, d);
+
+            // the half carries limb_bits more, its error vanishes in the square
+            const std::size_t h = k / 2 + limb_bits;
+            std::vector<limb> r = reciprocal(b, h);
+            shift_left(r, k - h);
+            bool e_sign = false;
+            add_signed(one, e_sign, multiply(d, r, uncapped), true);
+            std::vector<limb> c = multiply(r, one, uncapped);
+            shift_right(c, 2 * k);
+            bool r_sign = false;
+            add_signed(r, r_sign, c, e_sign);
+            return r;
+        }
+
+        // a / b for b != 0 within a few units, long quotients multiply by the reciprocal of b
+        BIG_NOINLINE inline std::vector<limb> quotient(const std::vector<limb>& a, const std::vector<limb>& b){
+            const std::size_t an = bit_length(a.data(), a.size());
+            const std::size_t bn = bit_length(b.data(), b.size());
+            if(an < bn)
+                return {};
+            const std::size_t k = an - bn + 1 + limb_bits;
+            if(k <= reciprocal_threshold || bn <= reciprocal_threshold)
+                return divide(a, b);
+
+            // a = x * 2^s and b = d * 2^(bn - k), so a / b = x * 2^(2 k) / d >> (k + bn - s)
+            std::vector<limb> x(a);
+            const std::size_t s = an > k + limb_bits ? an - k - limb_bits : 0;
+            shift_right(x, s);
+            x = multiply(x, reciprocal(b, k), uncapped);
+            shift_right(x, k + bn - s);
+            return x;
+        }
+
+        // split_term of a precision only known at run time
+        struct limb_term{
+            std::vector<limb> P;
+            std::vector<limb> Q;
+            std::vector<limb> T;
+            bool p_sign;
+            bool t_sign;
+
+            limb_term(std::vector<limb> p, std::vector<limb> q, std::vector<limb> t, bool p_negative, bool t_negative):
+                P(std::move(p)),
+                Q(std::move(q)),
+                T(std::move(t)),
+                p_sign(p_negative),
+                t_sign(t_negative){}
+
+            // out of line, every unwinding path calls it
+            BIG_NOINLINE ~limb_term(){}
+        };
+
+        BIG_NOINLINE inline void merge(limb_term& l, const limb_term& h){
+            l.T = multiply(l.T, h.Q, uncapped);
+            add_signed(l.T, l.t_sign, multiply(l.P, h.T, uncapped), l.p_sign != h.t_sign);
+            l.P = multiply(l.P, h.P, uncapped);
+            l.p_sign = l.p_sign != h.p_sign;
+            l.Q = multiply(l.Q, h.Q, uncapped);
+        }
+
+        // split on vectors, the factors of a single term fit in 128 bits
+        template<class Series>
+        limb_term split_limbs(unsigned long long a, unsigned long long b){
+            if(b - a == 1){
+                limb_term x{to_limbs(Series::template p<128>(a)), to_limbs(Series::template q<128>(a)), {},
+                            Series::negative(a), false};
+                x.T = multiply(x.P, to_limbs(Series::template a<128>(a)), uncapped);
+                x.t_sign = x.p_sign;
+                return x;
+            }
+            const unsigned long long m = a + (b - a) / 2;
+            limb_term l = split_limbs<Series>(a, m);
+            merge(l, split_limbs<Series>(m, b));
+            return l;
+        }
+
+        // extend on vectors
+        template<class Series>
+        void extend_limbs(constant_cache& c, unsigned long long n){
+            if(c.terms >= n)
+                return;
+
+            limb_term x = split_limbs<Series>(c.terms, n);
+            if(c.terms){
+                limb_term l{c.P, c.Q, c.T, c.p_sign, c.t_sign};
+                merge(l, x);
+                x = l;
+            }
+            c.terms = n;
+            c.P = x.P;
+            c.Q = x.Q;
+            c.T = x.T;
+            c.p_sign = x.p_sign;
+            c.t_sign = x.t_sign;
+        }
+
+        /**
+         * sqrt(d) * 2^bits within a unit or two
+         *
+         * as in root, the leading half is computed recursively and a
+         * single newton step at full size doubles its precision
+         */
+        BIG_NOINLINE inline std::vector<limb> sqrt_scaled(limb d, std::size_t bits){
+            if(bits <= limb_bits / 2){
+                const unsigned long long y = root_1(static_cast<unsigned long long>(d) << (2 * bits), 2);
+                return to_limbs(BigUint<64>(y));
+            }
+
+            const std::size_t h = bits / 2;
+            std::vector<limb> y = sqrt_scaled(d, bits - h);
+            shift_left(y, h);
+            // y = (y + d * 2^(2 bits) / y) / 2
+            std::vector<limb> a(1, d);
+            shift_left(a, 2 * bits);
+            bool sign = false;
+            add_signed(y, sign, quotient(a, y), false);
+            shift_right(y, 1);
+            return y;
+        }
+
+        struct two_over_pi_constant{};
+
+        /**
+         * floor(2 / pi * 2^bits), up to a few units too small, from the
+         * Chudnovsky series of pi_constant
+         *   2 / pi = T * sqrt(10005) / (213440 * 10005 * Q)
+         *
+         * the series state is kept in c, so a higher precision only sums
+         * the missing terms
+         */
+        BIG_NOINLINE inline std::vector<limb> two_over_pi(constant_cache& c, std::size_t bits){
+            constexpr std::size_t guard = 64;
+            extend_limbs<pi_constant>(c, pi_constant::terms(static_cast<long long>(bits + guard)));
+
+            // the leading bits + 2 guard bits of T and Q determine the quotient
+            std::vector<limb> t(c.T);
+            std::vector<limb> q(c.Q);
+            const std::size_t width = bit_length(q.data(), q.size());
+            if(width > bits + 2 * guard){
+                shift_right(t, width - bits - 2 * guard);
+                shift_right(q, width - bits - 2 * guard);
+            }
+            q.push_back(mul_1(q.data(), q.data(), q.size(), 2135467200));
+            q.resize(size(q.data(), q.size()));
+
+            std::vector<limb> x = quotient(multiply(t, sqrt_scaled(10005, bits + guard), uncapped), q);
+            shift_right(x, guard);
+            return x;
+        }
+
+        // bits first to last of 2 / pi after the binary point as an integer, from the value in c
+        inline std::vector<limb> fraction_bits(const constant_cache& c, std::size_t first, std::size_t last){
+            const std::size_t low = c.precision - last;
+            const std::size_t begin = low / limb_bits;
+            const std::size_t end = (c.precision - first) / limb_bits + 1;
+            if(begin >= c.value.size())
+                return {};
+            std::vector<limb> x(c.value.begin() + static_cast<std::ptrdiff_t>(begin),
+                                c.value.begin() + static_cast<std::ptrdiff_t>(end < c.value.size() ? end : c.value.size()));
+            shift_right(x, low % limb_bits);
+
+            const std::size_t n = last - first + 1;
+            if(x.size() > n / limb_bits){
+                x.resize(n / limb_bits + 1);
+                x.back() &= (limb(1) << (n % limb_bits)) - 1;
+                x.resize(size(x.data(), x.size()));
+            }
+            return x;
+        }
+
+        /**
+         * bits first to last of 2 / pi, the bit of weight 2^-first being
+         * the most significant one of the result
+         *
+         * unlike the cached constants the precision is only known at run
+         * time, it is grown to at least twice the previous one
+         */
+        BIG_NOINLINE inline std::vector<limb> two_over_pi_bits(std::size_t first, std::size_t last){
+            constant_cache& c = cache<two_over_pi_constant>();
+            {
+                std::shared_lock<std::shared_mutex> lock(c.mutex);
+                if(c.precision >= last)
+                    return fraction_bits(c, first, last);
+            }
+
+            std::unique_lock<std::shared_mutex> lock(c.mutex);
+            if(c.precision < last){
+                const std::size_t precision = last > 2 * c.precision ? last : 2 * c.precision;
+                c.value = two_over_pi(c, precision);
+                c.precision = precision;
+            }
+            return fraction_bits(c, first, last);
+        }
+
+        // largest ilogb of the arguments of sincos, 2 / pi to that many bits takes seconds
+        constexpr long long max_reduction_exponent = 1ll << 22;
+
+        /**
+         * x = n * pi / 2 + y with |y| <= pi / 4, returns n mod 4
+         *
+         * Payne-Hanek reduction, with x = m * 2^e the bits of 2 / pi of
+         * weight 2^(2 - e) and above only add multiples of 4 to x * 2 / pi,
+         * and 2 * precision + 64 bits below 2^-e leave the fraction exact to
+         * the precision of y, even next to a multiple of pi / 2. the cost
+         * does not depend on x, only the first reduction of a larger x
+         * extends 2 / pi.
+         */
+        template<class F>
+        unsigned long long reduce_half_pi(const F& x, F& y){
+            constexpr std::size_t precision = static_cast<std::size_t>(float_traits<F>::precision);
+            // fraction bits of m * w, x * 2 / pi = m * w * 2^-frac modulo 4
+            constexpr std::size_t frac = 2 * precision + 64;
+            const long long e = x.exponent();
+            const std::vector<limb> w = two_over_pi_bits(e > 1 ? static_cast<std::size_t>(e - 1) : 0,
+                                                         static_cast<std::size_t>(e + static_cast<long long>(frac)));
+            std::vector<limb> t = multiply(x.mantissa().limbs(), x.mantissa().limb_count, w.data(), w.size(), uncapped);
+            t.resize(frac / limb_bits + 1 > t.size() ? frac / limb_bits + 1 : t.size(), 0);
+
+            const auto bit = [&t](std::size_t i){
+                return static_cast<unsigned long long>((t[i / limb_bits] >> (i % limb_bits)) & 1);
+            };
+            unsigned long long n = (bit(frac) + 2 * (frac + 1 < t.size() * limb_bits ? bit(frac + 1) : 0)) & 3;
+            t.resize(frac / limb_bits + 1);
+            const limb mask = (limb(1) << (frac % limb_bits)) - 1;
+            t.back() &= mask;
+
+            // round to the nearest multiple, y = (f - 1) * pi / 2
+            bool negative = false;
+            if(bit(frac - 1)){
+                for(limb& l : t)
+                    l = ~l;
+                add_1(t.data(), t.data(), t.size(), 1);
+                t.back() &= mask;
+                n = (n + 1) & 3;
+                negative = true;
+            }
+
+            const std::size_t bits = bit_length(t.data(), t.size());
+            const std::size_t drop = bits > precision ? bits - precision : 0;
+            shr(t.data(), t.size(), drop);
+            y = ldexp(F(from_limbs<precision>(t)) * cached<pi_constant, F>(),
+                      static_cast<long long>(drop) - static_cast<long long>(frac) - 1);
+            if(negative != x.sign())
+                -y;
+            return x.sign() ? (4 - n) & 3 : n;
+        }
+
+        template<class F>
+        void sincos(const F& x, F& sin, F& cos){
+            if(!x.mantissa()){
+                sin = F(0ull);
+                cos = F(1ull);
+                return;
+            }
+
+            if(ilogb(x) > max_reduction_exponent){
+                sin = F(0ull);
+                cos = F(0ull);
+                return;
+            }
+
+            // x = n * pi / 2 + y with |y| <= pi / 4, large x lose too many bits to the cancellation
+            F y(0ull);
+            unsigned long long n = 0;
+            if(ilogb(x) > 16){
+                n = reduce_half_pi(x, y);
+            }else{
+                const F half_pi = ldexp(cached<pi_constant, F>(), -1);
+                const F q = x / half_pi;
+                const long long m = static_cast<long long>(q + F(q.sign() ? -0.5 : 0.5));
+                y = x - F(m) * half_pi;
+                n = static_cast<unsigned long long>(m);
+            }
+
+            F s(0ull);
+            F c(1ull);
+            if(y.mantissa()){
+                const F v = versine(y);
+                c = F(1ull) - v;
+                s = detail::sqrt(v * (F(2ull) - v));
+                if(y.sign())
+                    -s;
+            }
+
+            switch(n & 3){
+            case 0:
+                sin = s;
+                cos = c;
+                break;
+            case 1:
+                sin = c;
+                cos = -s;
+                break;
+            case 2:
+                sin = -s;
+                cos = -c;
+                break;
+            default:
+                sin = -c;
+                cos = s;
+                break;
+            }
+        }
+
+        /**
+         * atan(x) for |x| <= 1 by newton iteration on tan(y) = x,
+         * the starting value is computed at half the precision
+         */
+        template<class F>
+        F atan_newton(const F& x){
+            constexpr long long precision = float_traits<F>::precision;
+            F y(0ull);
+            if constexpr(precision <= 96){
+                y = F(std::atan(static_cast<double>(x)));
+            }else{
+                using H = typename float_traits<F>::template with_precision<round_limbs(precision / 2 + 32)>;
+                y = F(atan_newton(H(x)));
+            }
+
+            // y - (tan(y) - x) * cos(y)^2
+            F sin(0ull);
+            F cos(0ull);
+            sincos(y, sin, cos);
+            return y + cos * (x * cos - sin);
+        }
+
+        template<class F>
+        F atan(const F& x){
+            if(!x.mantissa())
+                return x;
+            if(ilogb(x) < 0)
+                return atan_newton(x);
+
+            F y = ldexp(cached<pi_constant, F>(), -1);
+            if(x.sign())
+                -y;
+            return y - atan_newton(F(1ull) / x);
+        }
+
+        template<class F, class T>
+        F from_arithmetic(const T& x){
+            if constexpr(std::is_integral<T>::value && std::is_signed<T>::value)
+                return F(static_cast<long long>(x));
+            else if constexpr(std::is_integral<T>::value)
+                return F(static_cast<unsigned long long>(x));
+            else if constexpr(std::is_floating_point<T>::value)
+                return F(static_cast<long double>(x));
+            else
+                return F(x);
+        }
+
+        template<class F>
+        F pow_integer(F x, long long n){
+            const bool inverse = n < 0;
+            F y = pow_uint(x, inverse ? 0ull - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n));
+            return inverse ? F(1ull) / y : y;
+        }
+    }
+
+    template<class F>
+    F const_pi(){
+        return detail::cached<detail::pi_constant, F>();
+    }
+
+    template<class F>
+    F const_log2(){
+        return detail::cached<detail::log2_constant, F>();
+    }
+
+    template<class F>
+    F const_log10(){
+        return detail::cached<detail::log10_constant, F>();
+    }
+
+    template<class F>
+    F const_e(){
+        return detail::cached<detail::e_constant, F>();
+    }
+
+    template<std::size_t N>
+    BigInt<N> abs(const BigInt<N>& x){
+        BigInt<N> y(x);
+        return y < BigInt<N>(0ll) ? -y : y;
+    }
+
+    template<std::size_t N>
+    BigUint<N> abs(const BigUint<N>& x){
+        return x;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> abs(const BigFloat<p, b, r>& x){
+        BigFloat<p, b, r> y(x);
+        return x.sign() ? -y : y;
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> sin(const BigFloat<p, b, r>& x){
+        detail::guarded<BigFloat<p, b, r>> s(0ull), c(0ull);
+        detail::sincos(detail::guarded<BigFloat<p, b, r>>(x), s, c);
+        return BigFloat<p, b, r>(s);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> cos(const BigFloat<p, b, r>& x){
+        detail::guarded<BigFloat<p, b, r>> s(0ull), c(0ull);
+        detail::sincos(detail::guarded<BigFloat<p, b, r>>(x), s, c);
+        return BigFloat<p, b, r>(c);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> tan(const BigFloat<p, b, r>& x){
+        detail::guarded<BigFloat<p, b, r>> s(0ull), c(0ull);
+        detail::sincos(detail::guarded<BigFloat<p, b, r>>(x), s, c);
+        if(!c.mantissa())
+            return BigFloat<p, b, r>(0ull);
+        return BigFloat<p, b, r>(s / c);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> sinh(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G u = detail::expm1(G(x));
+        return BigFloat<p, b, r>(ldexp(u + u / (u + G(1ull)), -1));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> cosh(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G v = detail::exp(G(abs(x)));
+        return BigFloat<p, b, r>(ldexp(v + G(1ull) / v, -1));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> tanh(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        if(x.mantissa() && ilogb(x) > 62){
+            BigFloat<p, b, r> one(1ull);
+            return x.sign() ? -one : one;
+        }
+        const G u = detail::expm1(ldexp(G(x), 1));
+        return BigFloat<p, b, r>(u / (u + G(2ull)));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> asin(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G y(x);
+        const G one(1ull);
+        const G a = abs(y);
+        if(a > one)
+            return BigFloat<p, b, r>(0ull);
+        if(a == one){
+            G z = ldexp(detail::cached<detail::pi_constant, G>(), -1);
+            return BigFloat<p, b, r>(x.sign() ? -z : z);
+        }
+        return BigFloat<p, b, r>(detail::atan(y / detail::sqrt((one - y) * (one + y))));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> acos(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G y(x);
+        const G one(1ull);
+        if(abs(y) > one)
+            return BigFloat<p, b, r>(0ull);
+        if(y == -G(one))
+            return BigFloat<p, b, r>(detail::cached<detail::pi_constant, G>());
+        return BigFloat<p, b, r>(ldexp(detail::atan(detail::sqrt((one - y) / (one + y))), 1));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> atan(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        return BigFloat<p, b, r>(detail::atan(G(x)));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> asinh(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G a = G(abs(x));
+        const G one(1ull);
+        G y = detail::log1p(a + a * a / (one + detail::sqrt(one + a * a)));
+        return BigFloat<p, b, r>(x.sign() ? -y : y);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> acosh(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G t = G(x) - G(1ull);
+        if(t.sign())
+            return BigFloat<p, b, r>(0ull);
+        return BigFloat<p, b, r>(detail::log1p(t + detail::sqrt(t * (t + G(2ull)))));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> atanh(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G y(x);
+        const G one(1ull);
+        if(abs(y) >= one)
+            return BigFloat<p, b, r>(0ull);
+        return BigFloat<p, b, r>(ldexp(detail::log1p(ldexp(y, 1) / (one - y)), -1));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> exp(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        return BigFloat<p, b, r>(detail::exp(G(x)));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> exp2(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        if(x.mantissa() && ilogb(x) > 62)
+            return x.sign() ? BigFloat<p, b, r>(0ull) : ldexp(BigFloat<p, b, r>(1ull), std::numeric_limits<long long>::max());
+
+        // the integer part only scales the result
+        const long long n = static_cast<long long>(x);
+        const G f = G(x) - G(n);
+        return BigFloat<p, b, r>(ldexp(detail::exp(f * detail::cached<detail::log2_constant, G>()), n));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> exp10(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        return BigFloat<p, b, r>(detail::exp(G(x) * detail::cached<detail::log10_constant, G>()));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> log(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        return BigFloat<p, b, r>(detail::log(G(x)));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> log2(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        if(!x.sign() && x.mantissa() == (BigUint<p>(1ull) << (p - 1)))
+            return BigFloat<p, b, r>(ilogb(x));
+        return BigFloat<p, b, r>(detail::log(G(x)) / detail::cached<detail::log2_constant, G>());
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> log10(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        return BigFloat<p, b, r>(detail::log(G(x)) / detail::cached<detail::log10_constant, G>());
+    }
+
+    template<std::size_t N>
+    BigInt<N> hypot(const BigInt<N>& x, const BigInt<N>& y){
+        return BigInt<N>(hypot(detail::magnitude(x), detail::magnitude(y)));
+    }
+
+    template<std::size_t N>
+    BigUint<N> hypot(const BigUint<N>& x, const BigUint<N>& y){
+        // x^2 + y^2 is accumulated in place at double width
+        constexpr std::size_t n = BigUint<N>::limb_count;
+        BigUint<2 * N + detail::limb_bits> s(0ull);
+        detail::addmul(s.limbs(), s.limb_count, x.limbs(), n, x.limbs(), detail::size(x.limbs(), n));
+        detail::addmul(s.limbs(), s.limb_count, y.limbs(), n, y.limbs(), detail::size(y.limbs(), n));
+        return BigUint<N>(detail::root(s, 2));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> hypot(const BigFloat<p, b, r>& x, const BigFloat<p, b, r>& y){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        const G gx(x);
+        const G gy(y);
+        return BigFloat<p, b, r>(detail::sqrt(gx * gx + gy * gy));
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> sqrt(const BigFloat<p, b, r>& x){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        return BigFloat<p, b, r>(detail::sqrt(G(x)));
+    }
+
+    template<std::size_t N>
+    BigInt<N> sqrt(const BigInt<N>& x){
+        return isqrt(x);
+    }
+
+    template<std::size_t N>
+    BigUint<N> sqrt(const BigUint<N>& x){
+        return isqrt(x);
+    }
+
+    template<std::size_t N>
+    BigInt<N> isqrt(const BigInt<N>& x){
+        BigInt<N> rem(0ll);
+        return sqrtrem(x, rem);
+    }
+
+    template<std::size_t N>
+    BigUint<N> isqrt(const BigUint<N>& x){
+        return detail::root(x, 2);
+    }
+
+    template<std::size_t N>
+    BigInt<N> sqrtrem(const BigInt<N>& x, BigInt<N>& rem){
+        if(x < BigInt<N>(0ll)){
+            rem = x;
+            return BigInt<N>(0ll);
+        }
+        BigUint<N> r(0ull);
+        const BigUint<N> s = sqrtrem(detail::magnitude(x), r);
+        rem = BigInt<N>(r);
+        return BigInt<N>(s);
+    }
+
+    template<std::size_t N>
+    BigUint<N> sqrtrem(const BigUint<N>& x, BigUint<N>& rem){
+        const BigUint<N> s = detail::root(x, 2);
+        rem = x - s * s;
+        return s;
+    }
+
+    template<std::size_t N>
+    BigInt<N> iroot(const BigInt<N>& x, unsigned long long k){
+        if(!k)
+            return BigInt<N>(0ll);
+        const bool negative = x < BigInt<N>(0ll);
+        if(negative && !(k & 1))
+            return BigInt<N>(0ll);
+        BigInt<N> y(detail::root(detail::magnitude(x), k));
+        return negative ? -y : y;
+    }
+
+    template<std::size_t N>
+    BigUint<N> iroot(const BigUint<N>& x, unsigned long long k){
+        if(!k)
+            return BigUint<N>(0ull);
+        return detail::root(x, k);
+    }
+
+    template<std::size_t N>
+    bool is_perfect_square(const BigInt<N>& x){
+        return !(x < BigInt<N>(0ll)) && is_perfect_square(detail::magnitude(x));
+    }
+
+    template<std::size_t N>
+    bool is_perfect_square(const BigUint<N>& x){
+        if(!x || !detail::square_residue(x))
+            return !x;
+        const BigUint<N> y = detail::root(x, 2);
+        return y * y == x;
+    }
+
+    template<std::size_t N>
+    bool is_perfect_power(const BigInt<N>& x){
+        return detail::perfect_power(detail::magnitude(x), x < BigInt<N>(0ll));
+    }
+
+    template<std::size_t N>
+    bool is_perfect_power(const BigUint<N>& x){
+        return detail::perfect_power(x, false);
+    }
+
+    template<std::size_t N>
+    constexpr BigInt<N> gcd(const BigInt<N>& a, const BigInt<N>& b){
+        return BigInt<N>(gcd(detail::magnitude(a), detail::magnitude(b)));
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N> gcd(const BigUint<N>& a, const BigUint<N>& b){
+        // one division first, the binary algorithm is slow on unbalanced operands
+        BigUint<N> x(a < b ? b : a);
+        BigUint<N> y(a < b ? a : b);
+        if(y)
+            x %= y;
+        BigUint<N> r(0ull);
+        detail::gcd(r.limbs(), x.limbs(), y.limbs(), r.limb_count);
+        return r;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N> powm(const BigUint<N>& base, const BigUint<N>& exp, const BigUint<N>& m){
+        if(m <= BigUint<N>(1ull))
+            return BigUint<N>(0ull);
+        if(m.limbs()[0] & 1){
+            const detail::montgomery<N> mont(m);
+            return mont.from(mont.pow(mont.to(base), exp));
+        }
+
+        return detail::powm_even(base, exp, m);
+    }
+
+    template<std::size_t N>
+    BigUint<N> factorial(unsigned long long n, unsigned threads){
+        static_assert(N < detail::max_factor, "Big::factorial: N must be below 2^32");
+        const unsigned long long ones = detail::popcount(n);
+        // also keeps n below 2^32
+        if(n - ones >= N)
+            return BigUint<N>(0ull);
+
+        const std::vector<detail::limb> primes = detail::primes_up_to(n);
+        BigUint<N> x = detail::from_limbs<N>(detail::odd_factorial(n, primes, BigUint<N>::limb_count, threads));
+        return x << (n - ones);
+    }
+
+    template<std::size_t N>
+    BigUint<N> binomial(unsigned long long n, unsigned long long k, unsigned threads){
+        if(k > n)
+            return BigUint<N>(0ull);
+        if(k > n - k)
+            k = n - k;
+
+        if(n >= detail::max_factor){
+            // Kummer's theorem, C(n, k) has a factor 2 for every carry of k + (n - k)
+            const unsigned long long carries = detail::popcount(k) + detail::popcount(n - k) - detail::popcount(n);
+            if(carries >= N)
+                return BigUint<N>(0ull);
+            const auto parts = detail::odd_binomial(n, k, BigUint<N>::limb_count, threads);
+            const BigUint<N> d = detail::from_limbs<N>(parts.second);
+            // d^-1 modulo 2^N by newton iteration, an odd d is its own inverse modulo 8
+            BigUint<N> inv = d;
+            for(std::size_t bits = 3; bits < N; bits *= 2)
+                inv *= BigUint<N>(2ull) - d * inv;
+            return (detail::from_limbs<N>(parts.first) * inv) << carries;
+        }
+
+        // Legendre's formula, p^e <= n for every prime power in C(n, k)
+        std::vector<detail::limb> factors;
+        for(const detail::limb p : detail::primes_up_to(n)){
+            detail::limb f = 1;
+            for(unsigned long long q = p; q <= n; q *= p){
+                if(n / q - k / q - (n - k) / q)
+                    f *= p;
+                if(q > n / p)
+                    break;
+            }
+            if(f > 1)
+                factors.push_back(f);
+        }
+        return detail::from_limbs<N>(detail::product_tree(factors, BigUint<N>::limb_count, threads));
+    }
+
+    template<std::size_t N>
+    BigUint<N> primorial(unsigned long long n, unsigned threads){
+        return detail::from_limbs<N>(detail::primorial(n, BigUint<N>::limb_count, threads));
+    }
+
+    template<std::size_t N>
+    BigUint<N> product(const BigUint<N>* values, std::size_t count, unsigned threads){
+        return detail::from_limbs<N>(detail::product_tree(0, count, BigUint<N>::limb_count, threads, [&](std::size_t i){
+            return std::make_pair(values[i].limbs(), detail::size(values[i].limbs(), values[i].limb_count));
+        }));
+    }
+
+    template<std::size_t p, int b, std::size_t r, class T>
+    BigFloat<p, b, r> pow(const BigFloat<p, b, r>& base, const T& exp){
+        if constexpr(std::is_integral<T>::value){
+            using G = detail::guarded<BigFloat<p, b, r>>;
+            if constexpr(std::is_signed<T>::value)
+                return BigFloat<p, b, r>(detail::pow_integer(G(base), static_cast<long long>(exp)));
+            else
+                return BigFloat<p, b, r>(detail::pow_uint(G(base), static_cast<unsigned long long>(exp)));
+        }else{
+            return pow(base, detail::from_arithmetic<BigFloat<p, b, r>>(exp));
+        }
+    }
+
+    template<std::size_t p, int b, std::size_t r, class T>
+    BigFloat<p, b, r> pow(const T& base, const BigFloat<p, b, r>& exp){
+        return pow(detail::from_arithmetic<BigFloat<p, b, r>>(base), exp);
+    }
+
+    template<std::size_t p, int b, std::size_t r>
+    BigFloat<p, b, r> pow(const BigFloat<p, b, r>& base, const BigFloat<p, b, r>& exp){
+        using G = detail::guarded<BigFloat<p, b, r>>;
+        if(!exp.mantissa())
+            return BigFloat<p, b, r>(1ull);
+        if(trunc(exp) == exp && ilogb(exp) < 62)
+            return BigFloat<p, b, r>(detail::pow_integer(G(base), static_cast<long long>(exp)));
+        if(base.sign() || !base.mantissa())
+            return BigFloat<p, b, r>(0ull);
+        return BigFloat<p, b, r>(detail::exp(G(exp) * detail::log(G(base))));
+    }
 }
 
 #endif /* BIGINT_BIGMATH_HPP */
@@ -0,0 +1,406 @@
+/**
+ * @file   BigInt/include/BigPrime.hpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Library for representing big integers
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BIGINT_BIGPRIME_HPP
+#define BIGINT_BIGPRIME_HPP
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "BigUint.hpp"
+#include "BigMath.hpp"
+
+namespace Big{
+    /**
+     * Baillie-PSW test, a strong base 2 test followed by a strong lucas
+     * test, and rounds further Miller-Rabin tests with pseudo random bases
+     *
+     * there is no known composite passing BPSW, and none below 2^64
+     */
+    template<std::size_t N> bool is_probable_prime(const BigUint<N>& n, unsigned rounds = 0);
+
+    /**
+     * smallest probable prime > n, 0 if there is none below 2^N
+     *
+     * the candidates are sieved in windows and tested on up to threads threads
+     */
+    template<std::size_t N> BigUint<N> next_prime(const BigUint<N>& n, unsigned threads = 1);
+
+    /**
+     * random probable prime of exactly bits bits, 0 unless 2 <= bits <= N
+     */
+    template<std::size_t N, class URBG> BigUint<N> random_prime(std::size_t bits, URBG& g, unsigned threads = 1);
+
+    namespace detail{
+        // odd primes below 2^16
+        BIG_NOINLINE inline const std::vector<limb>& small_primes(){
+            static const std::vector<limb> primes = []{
+                std::vector<limb> p = primes_up_to((1ull << 16) - 1);
+                p.erase(p.begin());
+                return p;
+            }();
+            return primes;
+        }
+
+        // product of the first odd primes, as many as fit into N - 1 bits
+        template<std::size_t N>
+        const BigUint<N>& prime_product(){
+            static const BigUint<N> product = []{
+                BigUint<N> x(1ull);
+                for(const limb p : small_primes()){
+                    if(x.bit_length() + bits_of(p) > N - 1)
+                        break;
+                    x *= BigUint<N>(static_cast<unsigned long long>(p));
+                }
+                return x;
+            }();
+            return product;
+        }
+
+        // jacobi symbol (a / m) for an odd m
+        constexpr int jacobi_1(unsigned long long a, unsigned long long m){
+            int j = 1;
+            a %= m;
+            while(a){
+                while(!(a & 1)){
+                    a >>= 1;
+                    if((m & 7) == 3 || (m & 7) == 5)
+                        j = -j;
+                }
+                const unsigned long long t = a;
+                a = m;
+                m = t;
+                if((a & 3) == 3 && (m & 3) == 3)
+                    j = -j;
+                a %= m;
+            }
+            return m == 1 ? j : 0;
+        }
+
+        // jacobi symbol (d / n) for a small odd d and an odd n
+        template<std::size_t N>
+        int jacobi(long long d, const BigUint<N>& n){
+            const unsigned long long a = static_cast<unsigned long long>(d < 0 ? -d : d);
+            const limb n4 = n.limbs()[0] & 3;
+
+            // quadratic reciprocity, and (-1 / n) = -1 for n = 3 (mod 4)
+            int j = jacobi_1(mod_1(n, static_cast<limb>(a)), a);
+            if((a & 3) == 3 && n4 == 3)
+                j = -j;
+            if(d < 0 && n4 == 3)
+                j = -j;
+            return j;
+        }
+
+        template<std::size_t N>
+        BigUint<N> add_mod(const BigUint<N>& a, const BigUint<N>& b, const BigUint<N>& n){
+            BigUint<N> r(0ull);
+            const limb carry = add_n(r.limbs(), a.limbs(), b.limbs(), r.limb_count);
+            if(carry || !(r < n))
+                r -= n;
+            return r;
+        }
+
+        template<std::size_t N>
+        BigUint<N> sub_mod(const BigUint<N>& a, const BigUint<N>& b, const BigUint<N>& n){
+            return a < b ? a + (n - b) : a - b;
+        }
+
+        // a / 2 mod n for an odd n
+        template<std::size_t N>
+        BigUint<N> half_mod(const BigUint<N>& a, const BigUint<N>& n){
+            if(!(a.limbs()[0] & 1))
+                return a >> 1;
+            BigUint<N> r(0ull);
+            const limb carry = add_n(r.limbs(), a.limbs(), n.limbs(), r.limb_count);
+            r >>= 1;
+            r.limbs()[r.limb_count - 1] |= carry << (limb_bits - 1);
+            return r;
+        }
+
+        // n - 1 = d * 2^s
+        template<std::size_t N>
+        bool strong_probable_prime(const montgomery<N>& mont, const BigUint<N>& base){
+            const BigUint<N>& n = mont.modulus();
+            const BigUint<N> one = mont.one();
+            const BigUint<N> minus_one = n - one;
+            BigUint<N> d = n - BigUint<N>(1ull);
+            const std::size_t s = trailing_zeros(d.limbs());
+            d >>= s;
+
+            BigUint<N> x = mont.pow(mont.to(base), d);
+            if(x == one || x == minus_one)
+                return true;
+            for(std::size_t i = 1; i < s; ++i){
+                x = mont.mul(x, x);
+                if(x == minus_one)
+                    return true;
+                if(x == one)
+                    return false;
+            }
+            return false;
+        }
+
+        /**
+         * strong lucas test with Selfridge's parameters, P = 1, Q = (1 - D) / 4
+         * and D the first of 5, -7, 9, -11, ... with (D / n) = -1
+         *
+         * n + 1 = d * 2^s, passes if U(d) = 0 or V(d * 2^r) = 0 for some r < s
+         */
+        template<std::size_t N>
+        bool strong_lucas_probable_prime(const montgomery<N>& mont){
+            const BigUint<N>& n = mont.modulus();
+            long long D = 5;
+            for(int tries = 0; ; ++tries){
+                const int j = jacobi(D, n);
+                if(j < 0)
+                    break;
+                if(!j && BigUint<N>(static_cast<unsigned long long>(D < 0 ? -D : D)) != n)
+                    return false;
+                // there is no such D for squares
+                if(tries == 4 && is_perfect_square(n))
+                    return false;
+                D = D > 0 ? -(D + 2) : 2 - D;
+            }
+
+            const auto to_signed = [&](long long v){
+                const BigUint<N> x = mont.to(BigUint<N>(static_cast<unsigned long long>(v < 0 ? -v : v)));
+                return v < 0 && x ? n - x : x;
+            };
+            const BigUint<N> md = to_signed(D);
+            const BigUint<N> mq = to_signed((1 - D) / 4);
+
+            // the low s bits of n are set, so (n + 1) / 2^s = (n >> s) + 1
+            BigUint<N> t(n);
+            ~t;
+            const std::size_t s = t ? trailing_zeros(t.limbs()) : N;
+            const BigUint<N> d = (n >> s) + BigUint<N>(1ull);
+
+            BigUint<N> U = mont.one();
+            BigUint<N> V = U;
+            BigUint<N> Qk = mq;
+            for(std::size_t i = d.bit_length() - 1; i-- > 0;){
+                // U(2k) = U(k) V(k), V(2k) = V(k)^2 - 2 Q^k
+                U = mont.mul(U, V);
+                V = sub_mod(mont.mul(V, V), add_mod(Qk, Qk, n), n);
+                Qk = mont.mul(Qk, Qk);
+                if((d.limbs()[i / limb_bits] >> (i % limb_bits)) & 1){
+                    // U(k + 1) = (P U(k) + V(k)) / 2, V(k + 1) = (D U(k) + P V(k)) / 2
+                    const BigUint<N> u = U;
+                    U = half_mod(add_mod(U, V, n), n);
+                    V = half_mod(add_mod(mont.mul(md, u), V, n), n);
+                    Qk = mont.mul(Qk, mq);
+                }
+            }
+            if(!U || !V)
+                return true;
+            for(std::size_t r = 1; r < s; ++r){
+                V = sub_mod(mont.mul(V, V), add_mod(Qk, Qk, n), n);
+                Qk = mont.mul(Qk, Qk);
+                if(!V)
+                    return true;
+            }
+            return false;
+        }
+
+        // BPSW for an odd n > 2^32 without small factors
+        template<std::size_t N>
+        bool probable_prime(const BigUint<N>& n, unsigned rounds){
+            const montgomery<N> mont(n);
+            if(!strong_probable_prime(mont, BigUint<N>(2ull)) || !strong_lucas_probable_prime(mont))
+                return false;
+
+            // the bases only depend on n, so the answer is reproducible
+            std::seed_seq seed(n.limbs(), n.limbs() + n.limb_count);
+            std::mt19937 g(seed);
+            const BigUint<N> range = n - BigUint<N>(3ull);
+            for(unsigned i = 0; i < rounds; ++i){
+                BigUint<N> a(0ull);
+                for(std::size_t j = 0; j < a.limb_count; ++j)
+                    a.limbs()[j] = static_cast<limb>(g());
+                if(!strong_probable_prime(mont, a % range + BigUint<N>(2ull)))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * index of the first prime x + 2 * offsets[i], offsets.size() if
+         * there is none, the candidates are handed out in order so the
+         * result doesn't depend on the number of threads
+         */
+        template<std::size_t N>
+        std::size_t first_prime(const BigUint<N>& x, const std::vector<std::size_t>& offsets, unsigned threads){
+            const auto test = [&](std::size_t i){
+                return probable_prime(x + BigUint<N>(2ull * offsets[i]), 0);
+            };
+            if(threads <= 1 || offsets.size() < 2){
+                for(std::size_t i = 0; i < offsets.size(); ++i)
+                    if(test(i))
+                        return i;
+                return offsets.size();
+            }
+
+            std::atomic<std::size_t> next(0);
+            std::atomic<std::size_t> found(offsets.size());
+            const auto worker = [&]{
+                for(;;){
+                    const std::size_t i = next++;
+                    if(i >= found.load())
+                        return;
+                    if(test(i)){
+                        std::size_t f = found.load();
+                        while(i < f && !found.compare_exchange_weak(f, i)){}
+                    }
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for(unsigned t = 1; t < threads && t < offsets.size(); ++t)
+                pool.emplace_back(worker);
+            worker();
+            for(std::thread& t : pool)
+                t.join();
+            return found.load();
+        }
+
+        /**
+         * smallest probable prime >= x of at most max_bits bits, 0 if there is none
+         *
+         * odd candidates are sieved by the small primes one window at a
+         * time, the residues of the window start are only computed once
+         * and then advanced
+         */
+        template<std::size_t N>
+        BigUint<N> search(BigUint<N> x, std::size_t max_bits, unsigned threads){
+            const BigUint<N> two(2ull);
+            if(x <= two)
+                return max_bits >= 2 ? two : BigUint<N>(0ull);
+            if(!(x.limbs()[0] & 1))
+                ++x;
+
+            // the sieve would strike out the small primes themselves
+            for(; x.bit_length() <= 32; x += two)
+                if(is_small_prime(static_cast<unsigned long long>(x)))
+                    return x.bit_length() <= max_bits ? x : BigUint<N>(0ull);
+
+            constexpr std::size_t window = 4096;
+            const std::vector<limb>& primes = small_primes();
+            const std::size_t bits = x.bit_length();
+            const unsigned long long limit = bits < 256 ? bits * bits : 1ull << 16;
+            std::size_t count = 0;
+            while(count < primes.size() && primes[count] < limit)
+                ++count;
+
+            std::vector<limb> residue(count);
+            for(std::size_t i = 0; i < count; ++i)
+                residue[i] = mod_1(x, primes[i]);
+
+            std::vector<bool> composite;
+            std::vector<std::size_t> offsets;
+            for(;;){
+                if(x.bit_length() > max_bits)
+                    return BigUint<N>(0ull);
+
+                composite.assign(window, false);
+                for(std::size_t i = 0; i < count; ++i){
+                    // x + 2 * j = 0 (mod p) for j = -x / 2 (mod p)
+                    const std::size_t p = primes[i];
+                    const std::size_t r = residue[i];
+                    for(std::size_t j = r ? ((p - r) & 1 ? 2 * p - r : p - r) / 2 : 0; j < window; j += p)
+                        composite[j] = true;
+                    residue[i] = static_cast<limb>((r + 2 * window) % p);
+                }
+
+                offsets.clear();
+                const BigUint<N> end = x + BigUint<N>(2ull * window);
+                const bool wraps = end < x;
+                for(std::size_t j = 0; j < window; ++j)
+                    if(!composite[j] && !(wraps && x + BigUint<N>(2ull * j) < x))
+                        offsets.push_back(j);
+
+                const std::size_t i = first_prime(x, offsets, threads);
+                if(i < offsets.size()){
+                    const BigUint<N> p = x + BigUint<N>(2ull * offsets[i]);
+                    return p.bit_length() <= max_bits ? p : BigUint<N>(0ull);
+                }
+                if(wraps)
+                    return BigUint<N>(0ull);
+                x = end;
+            }
+        }
+    }
+
+    template<std::size_t N>
+    bool is_probable_prime(const BigUint<N>& n, unsigned rounds){
+        if(n.bit_length() <= 32)
+            return detail::is_small_prime(static_cast<unsigned long long>(n));
+        if(!(n.limbs()[0] & 1))
+            return false;
+
+        // trial division by all small primes at once
+        if(gcd(n, detail::prime_product<N>()) != BigUint<N>(1ull))
+            return false;
+        return detail::probable_prime(n, rounds);
+    }
+
+    template<std::size_t N>
+    BigUint<N> next_prime(const BigUint<N>& n, unsigned threads){
+        BigUint<N> x(n);
+        if(!++x)
+            return x;
+        return detail::search(x, N, threads);
+    }
+
+    template<std::size_t N, class URBG>
+    BigUint<N> random_prime(std::size_t bits, URBG& g, unsigned threads){
+        if(bits < 2 || bits > N)
+            return BigUint<N>(0ull);
+
+        std::uniform_int_distribution<detail::limb> limbs;
+        for(;;){
+            // a random start with the top bit set, retried if the search runs past 2^bits
+            BigUint<N> x(0ull);
+            for(std::size_t i = 0; i < x.limb_count; ++i)
+                x.limbs()[i] = limbs(g);
+            x >>= N - bits;
+            x |= BigUint<N>(1ull) << (bits - 1);
+
+            const BigUint<N> p = detail::search(x, bits, threads);
+            if(p)
+                return p;
+        }
+    }
+}
+
+#endif /* BIGINT_BIGPRIME_HPP */
@@ -0,0 +1,106 @@
+/**
+ * @file   BigInt/include/BigStats.hpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Library for representing big integers
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BIGINT_BIGSTATS_HPP
+#define BIGINT_BIGSTATS_HPP
+
+/**
+ * optional operation counters, compiled in by defining BIG_STATS
+ *
+ * without BIG_STATS the hooks expand to nothing, with it every
+ * thread counts into its own counters and nothing is counted during
+ * constant evaluation.
+ */
+#ifdef BIG_STATS
+
+namespace Big{
+    namespace stats{
+        struct counters{
+            // limbs passed through the kernels
+            unsigned long long add_limbs;
+            unsigned long long mul_limbs;
+            unsigned long long div_limbs;
+            unsigned long long shift_limbs;
+
+            // algorithm selections
+            unsigned long long mul_schoolbook;
+            unsigned long long mul_karatsuba;
+            unsigned long long mul_unbalanced;
+            unsigned long long div_1;
+            unsigned long long div_knuth;
+            unsigned long long mont_mul;
+            unsigned long long gcd_binary;
+
+            // numbers copied and scratch buffers set up by the operators
+            unsigned long long copies;
+            unsigned long long scratch;
+        };
+
+        inline counters& current()noexcept{
+            static thread_local counters c{};
+            return c;
+        }
+
+        inline void reset()noexcept{
+            current() = counters{};
+        }
+
+        // calls f(name, value) for every counter
+        template<class F>
+        void for_each(const counters& c, F f){
+            f("add_limbs", c.add_limbs);
+            f("mul_limbs", c.mul_limbs);
+            f("div_limbs", c.div_limbs);
+            f("shift_limbs", c.shift_limbs);
+            f("mul_schoolbook", c.mul_schoolbook);
+            f("mul_karatsuba", c.mul_karatsuba);
+            f("mul_unbalanced", c.mul_unbalanced);
+            f("div_1", c.div_1);
+            f("div_knuth", c.div_knuth);
+            f("mont_mul", c.mont_mul);
+            f("gcd_binary", c.gcd_binary);
+            f("copies", c.copies);
+            f("scratch", c.scratch);
+        }
+    }
+};
+
+#define BIG_STATS_ADD(counter, n)                                       \
+    (__builtin_is_constant_evaluated() ? void() :                       \
+     void(::Big::stats::current().counter += (n)))
+
+#else
+
+#define BIG_STATS_ADD(counter, n) ((void)0)
+
+#endif
+
+#endif /* BIGINT_BIGSTATS_HPP */
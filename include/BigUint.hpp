@@ -34,10 +34,14 @@
 
 #include <array>
 #include <climits>
+#include <cmath>
+#include <functional>
 #include <istream>
 #include <limits>
 #include <ostream>
 
+#include "BigKernel.hpp"
+
 namespace Big{
     template<std::size_t N>
     class BigUint{
@@ -46,7 +50,12 @@ namespace Big{
 
         std::array<unsigned int, N / (sizeof(unsigned int) * CHAR_BIT)> data;
 
+        template<std::size_t M>
+        friend class BigUint;
+
     public:
+        static constexpr std::size_t limb_count = N / (sizeof(unsigned int) * CHAR_BIT);
+
         constexpr BigUint() = default;
         constexpr BigUint(const BigUint& other)noexcept;
         constexpr BigUint(BigUint&& other)noexcept;
@@ -58,15 +67,27 @@ namespace Big{
         template<std::size_t M>
         constexpr BigUint(const BigUint<M>& other)noexcept;
 
-        BigUint& operator=(const BigUint& other)noexcept;
-        BigUint& operator=(BigUint&& other)noexcept;
-        BigUint& operator=(unsigned long long other)noexcept;
-        BigUint& operator=(float other)noexcept;
-        BigUint& operator=(double other)noexcept;
-        BigUint& operator=(long double other)noexcept;
+        constexpr BigUint& operator=(const BigUint& other)noexcept;
+        constexpr BigUint& operator=(BigUint&& other)noexcept;
+        constexpr BigUint& operator=(unsigned long long other)noexcept;
+        constexpr BigUint& operator=(float other)noexcept;
+        constexpr BigUint& operator=(double other)noexcept;
+        constexpr BigUint& operator=(long double other)noexcept;
 
         void swap(BigUint& other)noexcept;
 
+        explicit constexpr operator bool()const noexcept;
+        explicit constexpr operator unsigned long long()const noexcept;
+        explicit operator double()const noexcept;
+
+        /**
+         * raw access to the little endian limbs
+         */
+        constexpr const unsigned int* limbs()const noexcept;
+        constexpr unsigned int* limbs()noexcept;
+
+        constexpr std::size_t bit_length()const noexcept;
+
         constexpr BigUint& operator~()noexcept;
 
         constexpr BigUint& operator+=(const BigUint& rhs)noexcept;
@@ -92,16 +113,258 @@ namespace Big{
         friend std::istream& operator>>(std::istream& is, BigUint<M>& obj);
     };
 
+    template<std::size_t N>
+    constexpr BigUint<N>::BigUint(const BigUint& other)noexcept:
+        data(other.data){
+        BIG_STATS_ADD(copies, 1);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>::BigUint(BigUint&& other)noexcept:
+        data(other.data){
+        BIG_STATS_ADD(copies, 1);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>::BigUint(unsigned long long other)noexcept:
+        data{}{
+        for(std::size_t i = 0; i < limb_count && other; ++i){
+            data[i] = static_cast<unsigned int>(other);
+            other >>= detail::limb_bits;
+        }
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>::BigUint(float other)noexcept:
+        data{}{
+        detail::from_floating(data.data(), limb_count, other);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>::BigUint(double other)noexcept:
+        data{}{
+        detail::from_floating(data.data(), limb_count, other);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>::BigUint(long double other)noexcept:
+        data{}{
+        detail::from_floating(data.data(), limb_count, other);
+    }
+
+    template<std::size_t N>
+    template<std::size_t M>
+    constexpr BigUint<N>::BigUint(const BigUint<M>& other)noexcept:
+        data{}{
+        detail::copy(data.data(), other.data.data(), limb_count < other.limb_count ? limb_count : other.limb_count);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator=(const BigUint& other)noexcept{
+        data = other.data;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator=(BigUint&& other)noexcept{
+        data = other.data;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator=(unsigned long long other)noexcept{
+        return *this = BigUint(other);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator=(float other)noexcept{
+        return *this = BigUint(other);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator=(double other)noexcept{
+        return *this = BigUint(other);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator=(long double other)noexcept{
+        return *this = BigUint(other);
+    }
+
+    template<std::size_t N>
+    void BigUint<N>::swap(BigUint& other)noexcept{
+        data.swap(other.data);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>::operator bool()const noexcept{
+        return detail::size(data.data(), limb_count) != 0;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>::operator unsigned long long()const noexcept{
+        unsigned long long x = 0;
+        for(std::size_t i = limb_count; i-- > 0;){
+            if(i * detail::limb_bits < sizeof(unsigned long long) * CHAR_BIT)
+                x = (x << detail::limb_bits) | data[i];
+        }
+        return x;
+    }
+
+    template<std::size_t N>
+    BigUint<N>::operator double()const noexcept{
+        const std::size_t bits = bit_length();
+        const std::size_t wide = sizeof(unsigned long long) * CHAR_BIT;
+        if(bits <= wide)
+            return static_cast<double>(static_cast<unsigned long long>(*this));
+        return std::ldexp(static_cast<double>(static_cast<unsigned long long>(*this >> (bits - wide))),
+                          static_cast<int>(bits - wide));
+    }
+
+    template<std::size_t N>
+    constexpr const unsigned int* BigUint<N>::limbs()const noexcept{
+        return data.data();
+    }
+
+    template<std::size_t N>
+    constexpr unsigned int* BigUint<N>::limbs()noexcept{
+        return data.data();
+    }
+
+    template<std::size_t N>
+    constexpr std::size_t BigUint<N>::bit_length()const noexcept{
+        return detail::bit_length(data.data(), limb_count);
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator~()noexcept{
+        for(auto& l : data)
+            l = ~l;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator+=(const BigUint& rhs)noexcept{
+        detail::add_n(data.data(), data.data(), rhs.data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator-=(const BigUint& rhs)noexcept{
+        detail::sub_n(data.data(), data.data(), rhs.data.data(), limb_count);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator*=(const BigUint& rhs)noexcept{
+        BIG_STATS_ADD(scratch, 1);
+        std::array<unsigned int, limb_count> r{};
+        detail::mul_n<limb_count>(r.data(), data.data(), rhs.data.data());
+        data = r;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator/=(const BigUint& rhs)noexcept{
+        BIG_STATS_ADD(scratch, 1);
+        std::array<unsigned int, limb_count> q{};
+        std::array<unsigned int, limb_count + 1> un{};
+        std::array<unsigned int, limb_count> vn{};
+        detail::divmod(q.data(), nullptr, data.data(), rhs.data.data(), limb_count, un.data(), vn.data());
+        data = q;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator%=(const BigUint& rhs)noexcept{
+        BIG_STATS_ADD(scratch, 1);
+        std::array<unsigned int, limb_count> r{};
+        std::array<unsigned int, limb_count + 1> un{};
+        std::array<unsigned int, limb_count> vn{};
+        detail::divmod(nullptr, r.data(), data.data(), rhs.data.data(), limb_count, un.data(), vn.data());
+        data = r;
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator^=(const BigUint& rhs)noexcept{
+        for(std::size_t i = 0; i < limb_count; ++i)
+            data[i] ^= rhs.data[i];
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator&=(const BigUint& rhs)noexcept{
+        for(std::size_t i = 0; i < limb_count; ++i)
+            data[i] &= rhs.data[i];
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator|=(const BigUint& rhs)noexcept{
+        for(std::size_t i = 0; i < limb_count; ++i)
+            data[i] |= rhs.data[i];
+        return *this;
+    }
+
+    template<std::size_t N>
+    template<class IntType>
+    constexpr BigUint<N>& BigUint<N>::operator<<=(IntType shift)noexcept{
+        if(shift > 0)
+            detail::shl(data.data(), limb_count, static_cast<std::size_t>(shift));
+        return *this;
+    }
+
+    template<std::size_t N>
+    template<class IntType>
+    constexpr BigUint<N>& BigUint<N>::operator>>=(IntType shift)noexcept{
+        if(shift > 0)
+            detail::shr(data.data(), limb_count, static_cast<std::size_t>(shift));
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator++()noexcept{
+        detail::add_1(data.data(), data.data(), limb_count, 1);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N> BigUint<N>::operator++(int)noexcept{
+        BigUint tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N>& BigUint<N>::operator--()noexcept{
+        detail::sub_1(data.data(), data.data(), limb_count, 1);
+        return *this;
+    }
+
+    template<std::size_t N>
+    constexpr BigUint<N> BigUint<N>::operator--(int)noexcept{
+        BigUint tmp(*this);
+        --*this;
+        return tmp;
+    }
+
     template<std::size_t N>
     std::ostream& operator<<(std::ostream& os, const BigUint<N>& obj){
-        // write obj to stream
-        return os;
+        auto tmp = obj.data;
+        return os << detail::to_string(tmp.data(), tmp.size(), os.flags());
     }
 
     template<std::size_t N>
     std::istream& operator>>(std::istream& is, BigUint<N>& obj){
-        // read obj from stream
-        if( /* T could not be constructed */ true )
+        std::istream::sentry sentry(is);
+        if(!sentry)
+            return is;
+
+        decltype(obj.data) tmp{};
+        if(detail::from_stream(is, tmp.data(), tmp.size()))
+            obj.data = tmp;
+        else
             is.setstate(std::ios::failbit);
         return is;
     }
@@ -145,18 +408,18 @@ namespace Big{
     }
 
     template <std::size_t N, class IntType>
-    constexpr BigUint<N> operator<<(const BigUint<N>& lhs, IntType shift)noexcept{
+    constexpr BigUint<N> operator<<(BigUint<N> lhs, IntType shift)noexcept{
         return lhs <<= shift;
     }
     template <std::size_t N, class IntType>
-    constexpr BigUint<N> operator>>(const BigUint<N>& lhs, IntType shift)noexcept{
+    constexpr BigUint<N> operator>>(BigUint<N> lhs, IntType shift)noexcept{
         return lhs >>= shift;
     }
 
 
     template<std::size_t N>
     constexpr bool operator< (const BigUint<N>& lhs, const BigUint<N>& rhs) noexcept {
-        return false; // TODO
+        return detail::cmp(lhs.limbs(), rhs.limbs(), BigUint<N>::limb_count) < 0;
     }
     template<std::size_t N>
     constexpr bool operator> (const BigUint<N>& lhs, const BigUint<N>& rhs) noexcept {
@@ -173,12 +436,91 @@ namespace Big{
 
     template<std::size_t N>
     constexpr bool operator==(const BigUint<N>& lhs, const BigUint<N>& rhs) noexcept {
-        return false;
+        return detail::cmp(lhs.limbs(), rhs.limbs(), BigUint<N>::limb_count) == 0;
     }
     template<std::size_t N>
     constexpr bool operator!=(const BigUint<N>& lhs, const BigUint<N>& rhs) noexcept {
         return !(lhs == rhs);
     }
+
+    enum class byte_order{ little, big };
+
+    /**
+     * fixed writes all N / CHAR_BIT bytes, minimal only as many as
+     * the value needs (none for zero)
+     */
+    enum class byte_width{ fixed, minimal };
+
+    template<std::size_t N>
+    constexpr std::size_t export_size(const BigUint<N>& x, byte_width width = byte_width::fixed)noexcept{
+        if(width == byte_width::fixed)
+            return N / CHAR_BIT;
+        return (x.bit_length() + CHAR_BIT - 1) / CHAR_BIT;
+    }
+
+    /**
+     * writes x to out and returns the number of bytes written,
+     * out must hold at least export_size(x, width) bytes
+     */
+    template<std::size_t N>
+    constexpr std::size_t export_bytes(const BigUint<N>& x, unsigned char* out,
+                                       byte_order order = byte_order::little,
+                                       byte_width width = byte_width::fixed)noexcept{
+        const std::size_t size = export_size(x, width);
+        detail::export_bytes(out, x.limbs(), BigUint<N>::limb_count, size, order == byte_order::big);
+        return size;
+    }
+
+    /**
+     * reads size bytes from in into x, returns false if the value
+     * did not fit and was truncated modulo 2^N
+     */
+    template<std::size_t N>
+    constexpr bool import_bytes(BigUint<N>& x, const unsigned char* in, std::size_t size,
+                                byte_order order = byte_order::little)noexcept{
+        return detail::import_bytes(x.limbs(), BigUint<N>::limb_count, in, size, order == byte_order::big);
+    }
+
+    /**
+     * Big::literal<256>("0xffff'ffff"), the same digits as _bu into a
+     * BigUint<N> of the given width. In a constant expression a string
+     * that is not an integer literal or does not fit in N bits does not
+     * compile, at run time it yields the value modulo 2^N.
+     */
+    template<std::size_t N, std::size_t L>
+    constexpr BigUint<N> literal(const char (&s)[L])noexcept{
+        BigUint<N> x{};
+        if(!detail::literal_valid(s, L - 1) || !detail::from_literal(x.limbs(), BigUint<N>::limb_count, s, L - 1))
+            detail::literal_error();
+        return x;
+    }
+
+    inline namespace literals{
+        /**
+         * 0xffff'ffff_bu, parsed at compile time into a BigUint wide
+         * enough for any number with as many digits: 4 bits per hex,
+         * 3 per octal and 3.322 per decimal digit, rounded up to whole
+         * limbs, so 0xff_bu and 255_bu are both BigUint<32>. Use
+         * Big::literal for a fixed width.
+         */
+        template<char... Cs>
+        constexpr auto operator""_bu()noexcept{
+            static_assert(detail::literal_valid(detail::literal_chars<Cs...>, sizeof...(Cs)),
+                          "Big::operator\"\"_bu: not an integer literal");
+            constexpr std::size_t N = detail::literal_bits(detail::literal_chars<Cs...>, sizeof...(Cs));
+            constexpr BigUint<N> x = detail::literal_value<BigUint<N>, Cs...>();
+            return x;
+        }
+    }
 };
 
+namespace std{
+    template<std::size_t N>
+    struct hash<Big::BigUint<N>>{
+        std::size_t operator()(const Big::BigUint<N>& x)const noexcept{
+            return Big::detail::hash(x.limbs(), Big::BigUint<N>::limb_count);
+        }
+    };
+}
+
 #endif /* BIGINT_BIGUINT_HPP */
@@ -0,0 +1,191 @@
+/**
+ * @file   BigInt/include/BigUintView.hpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Library for representing big integers
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BIGINT_BIGUINTVIEW_HPP
+#define BIGINT_BIGUINTVIEW_HPP
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+#include "BigKernel.hpp"
+#include "BigUint.hpp"
+
+namespace Big{
+    /**
+     * read only view of N bits stored elsewhere as little endian limbs,
+     * for example in a mapped file or a network buffer
+     *
+     * the limbs must be suitably aligned for unsigned int and outlive
+     * the view, nothing is copied until a result is produced.
+     */
+    template<std::size_t N>
+    class BigUintView{
+        static_assert(!(N % (sizeof(unsigned int) * CHAR_BIT)),
+                      "Big::BigUintView: N must be a multiple of 'sizeof(unsigned int) * CHAR_BIT'");
+
+        const unsigned int* data;
+
+    public:
+        static constexpr std::size_t limb_count = BigUint<N>::limb_count;
+
+        explicit constexpr BigUintView(const unsigned int* limbs)noexcept:
+            data(limbs){}
+        constexpr BigUintView(const BigUint<N>& other)noexcept:
+            data(other.limbs()){}
+
+        constexpr const unsigned int* limbs()const noexcept{
+            return data;
+        }
+
+        constexpr std::size_t bit_length()const noexcept{
+            return detail::bit_length(data, limb_count);
+        }
+
+        // copies the viewed value
+        constexpr BigUint<N> value()const noexcept{
+            BigUint<N> r{};
+            detail::copy(r.limbs(), data, limb_count);
+            return r;
+        }
+
+        explicit constexpr operator bool()const noexcept{
+            return detail::size(data, limb_count) != 0;
+        }
+        explicit constexpr operator unsigned long long()const noexcept{
+            unsigned long long x = 0;
+            for(std::size_t i = limb_count; i-- > 0;){
+                if(i * detail::limb_bits < sizeof(unsigned long long) * CHAR_BIT)
+                    x = (x << detail::limb_bits) | data[i];
+            }
+            return x;
+        }
+
+        /*
+         * the operators are hidden friends so a BigUint<N> converts
+         * to a view on either side
+         */
+        friend constexpr BigUint<N> operator+(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> r{};
+            detail::add_n(r.limbs(), lhs.data, rhs.data, limb_count);
+            return r;
+        }
+        friend constexpr BigUint<N> operator-(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> r{};
+            detail::sub_n(r.limbs(), lhs.data, rhs.data, limb_count);
+            return r;
+        }
+        friend constexpr BigUint<N> operator*(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> r{};
+            detail::mul_n<limb_count>(r.limbs(), lhs.data, rhs.data);
+            return r;
+        }
+        friend constexpr BigUint<N> operator/(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> q{};
+            std::array<unsigned int, limb_count + 1> un{};
+            std::array<unsigned int, limb_count> vn{};
+            detail::divmod(q.limbs(), nullptr, lhs.data, rhs.data, limb_count, un.data(), vn.data());
+            return q;
+        }
+        friend constexpr BigUint<N> operator%(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> r{};
+            std::array<unsigned int, limb_count + 1> un{};
+            std::array<unsigned int, limb_count> vn{};
+            detail::divmod(nullptr, r.limbs(), lhs.data, rhs.data, limb_count, un.data(), vn.data());
+            return r;
+        }
+        friend constexpr BigUint<N> operator^(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> r{};
+            for(std::size_t i = 0; i < limb_count; ++i)
+                r.limbs()[i] = lhs.data[i] ^ rhs.data[i];
+            return r;
+        }
+        friend constexpr BigUint<N> operator&(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> r{};
+            for(std::size_t i = 0; i < limb_count; ++i)
+                r.limbs()[i] = lhs.data[i] & rhs.data[i];
+            return r;
+        }
+        friend constexpr BigUint<N> operator|(BigUintView lhs, BigUintView rhs)noexcept{
+            BigUint<N> r{};
+            for(std::size_t i = 0; i < limb_count; ++i)
+                r.limbs()[i] = lhs.data[i] | rhs.data[i];
+            return r;
+        }
+
+        friend constexpr BigUint<N> operator<<(BigUintView lhs, std::size_t shift)noexcept{
+            BigUint<N> r = lhs.value();
+            detail::shl(r.limbs(), limb_count, shift);
+            return r;
+        }
+        friend constexpr BigUint<N> operator>>(BigUintView lhs, std::size_t shift)noexcept{
+            BigUint<N> r = lhs.value();
+            detail::shr(r.limbs(), limb_count, shift);
+            return r;
+        }
+
+        friend constexpr bool operator< (BigUintView lhs, BigUintView rhs) noexcept {
+            return detail::cmp(lhs.data, rhs.data, limb_count) < 0;
+        }
+        friend constexpr bool operator> (BigUintView lhs, BigUintView rhs) noexcept {
+            return rhs < lhs;
+        }
+        friend constexpr bool operator<=(BigUintView lhs, BigUintView rhs) noexcept {
+            return !(lhs > rhs);
+        }
+        friend constexpr bool operator>=(BigUintView lhs, BigUintView rhs) noexcept {
+            return !(lhs < rhs);
+        }
+        friend constexpr bool operator==(BigUintView lhs, BigUintView rhs) noexcept {
+            return detail::cmp(lhs.data, rhs.data, limb_count) == 0;
+        }
+        friend constexpr bool operator!=(BigUintView lhs, BigUintView rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, BigUintView obj){
+            return os << obj.value();
+        }
+    };
+};
+
+namespace std{
+    template<std::size_t N>
+    struct hash<Big::BigUintView<N>>{
+        std::size_t operator()(Big::BigUintView<N> x)const noexcept{
+            return Big::detail::hash(x.limbs(), Big::BigUintView<N>::limb_count);
+        }
+    };
+}
+
+#endif /* BIGINT_BIGUINTVIEW_HPP */
@@ -0,0 +1,149 @@
+/**
+ * @file   BigInt/test/accumulator.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Carry save accumulator tests
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cassert>
+#include <random>
+#include <vector>
+
+#include "BigUint.hpp"
+#include "BigAccumulator.hpp"
+
+#include "random.hpp"
+
+namespace{
+    using A = Big::Accumulator<256>;
+    using W = A::result_type;
+
+    bool sums_to(const A& acc, const W& expected){
+        return acc.result() == expected;
+    }
+
+    // against the plain sum modulo 2^320, operands wider than the total are truncated
+    template<std::size_t M>
+    void sums(){
+        using U = Big::BigUint<M>;
+        std::mt19937_64 g(M);
+        A acc;
+        W expected(0ull);
+        std::vector<U> a;
+        std::vector<U> b;
+        for(int i = 0; i < 1000; ++i){
+            const U x = test::random<M>(g);
+            const U y = test::random<M>(g);
+            if(i % 3){
+                acc.addmul(x, y);
+                expected += W(x) * W(y);
+            }else{
+                acc.add(x);
+                expected += W(x);
+            }
+            a.push_back(x);
+            b.push_back(y);
+            assert(sums_to(acc, expected));
+        }
+        acc.dot(a.data(), b.data(), a.size());
+        for(std::size_t i = 0; i < a.size(); ++i)
+            expected += W(a[i]) * W(b[i]);
+        assert(sums_to(acc, expected));
+
+        acc.clear();
+        assert(sums_to(acc, W(0ull)));
+        acc.addmul(U(0ull), a[0]);
+        assert(sums_to(acc, W(0ull)));
+    }
+
+    /**
+     * all ones summands fill the lanes exactly to their bound, merging
+     * copies doubles the total until the summand count passes 2^32
+     * and the carries have to be resolved
+     */
+    void saturated(){
+        using U = Big::BigUint<256>;
+        const U ones = U(0ull) - U(1ull);
+        A acc;
+        W expected(0ull);
+        for(int i = 0; i < 40; ++i){
+            acc.add(ones);
+            expected += W(ones);
+
+            const A copy = acc;
+            acc.merge(copy);
+            expected <<= 1;
+            assert(sums_to(acc, expected));
+
+            // the copy may itself be too full to merge without resolving first
+            A fresh;
+            fresh.add(ones);
+            fresh.merge(acc);
+            assert(sums_to(fresh, expected + W(ones)));
+        }
+
+        // exactly 2^32 summands, too many to merge into anything unresolved
+        A full;
+        full.add(ones);
+        for(int i = 0; i < 31; ++i){
+            const A copy = full;
+            full.merge(copy);
+        }
+        A other;
+        other.merge(full);
+        assert(sums_to(other, W(ones) << 31));
+    }
+
+    // per thread accumulators merged into one total
+    void reduction(){
+        using U = Big::BigUint<256>;
+        std::mt19937_64 g(31);
+        A parts[4];
+        A all;
+        for(int i = 0; i < 4000; ++i){
+            const U x = test::random<256>(g);
+            const U y = test::random<256>(g);
+            parts[i % 4].addmul(x, y);
+            all.addmul(x, y);
+        }
+        A total;
+        for(const A& part : parts)
+            total.merge(part);
+        assert(sums_to(total, all.result()));
+        total.merge(A());
+        assert(sums_to(total, all.result()));
+    }
+}
+
+int main(){
+    sums<64>();
+    sums<256>();
+    sums<512>();
+    saturated();
+    reduction();
+    return 0;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file   BigInt/test/bench/bench.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Throughput benchmarks of the big integer operations
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BigUint.hpp"
+#include "BigMath.hpp"
+
+#include "../random.hpp"
+
+/**
+ * usage: bench [--format csv|json] [--min-time ms]
+ *              [--ops add,mul,sqr,mullo,div,to_dec,from_dec,powm,gcd]
+ *
+ * every operation runs on a rotating set of random operands until
+ * it took at least min-time, ns/op and the operand limbs per ns are
+ * reported. built with BIG_STATS the counters per operation are
+ * added to the output.
+ */
+namespace{
+    using clock = std::chrono::steady_clock;
+
+    constexpr std::size_t operands = 16;
+
+    struct options{
+        const char* format = "csv";
+        double min_ns = 50e6;
+        const char* ops = "add,mul,sqr,mullo,div,to_dec,from_dec,powm,gcd";
+    };
+
+    struct row{
+        const char* op;
+        std::size_t bits;
+        std::size_t limbs;
+        unsigned long long iterations;
+        double ns_per_op;
+#ifdef BIG_STATS
+        Big::stats::counters stats;
+#endif
+    };
+
+    volatile unsigned int sink;
+
+    // folds every limb of x into the sink, so no part of a result is dead code
+    template<std::size_t N>
+    void consume(const Big::BigUint<N>& x){
+        unsigned int s = 0;
+        for(std::size_t i = 0; i < x.limb_count; ++i)
+            s ^= x.limbs()[i];
+        sink = s;
+    }
+
+    bool selected(const options& opt, const std::string& op){
+        return ("," + std::string(opt.ops) + ",").find("," + op + ",") != std::string::npos;
+    }
+
+    // runs f(i) until it took min_ns, returns the time per call
+    template<class F>
+    double measure(const options& opt, F f, unsigned long long& iterations){
+        iterations = 1;
+        for(;;){
+#ifdef BIG_STATS
+            Big::stats::reset();
+#endif
+            const auto start = clock::now();
+            for(unsigned long long i = 0; i < iterations; ++i)
+                f(i % operands);
+            const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            if(ns >= opt.min_ns)
+                return ns / double(iterations);
+            const double scale = ns > 0 ? 1.2 * opt.min_ns / ns : 100;
+            iterations = static_cast<unsigned long long>(double(iterations) * (scale < 2 ? 2 : scale > 100 ? 100 : scale));
+        }
+    }
+
+    template<std::size_t N, class F>
+    void bench(const options& opt, std::vector<row>& rows, const char* op, F f){
+        if(!selected(opt, op))
+            return;
+        row r{};
+        r.op = op;
+        r.bits = N;
+        r.limbs = Big::BigUint<N>::limb_count;
+        r.ns_per_op = measure(opt, f, r.iterations);
+#ifdef BIG_STATS
+        r.stats = Big::stats::current();
+#endif
+        rows.push_back(r);
+        std::cerr << op << ' ' << N << ": " << r.ns_per_op << " ns/op" << std::endl;
+    }
+
+    template<std::size_t N>
+    void run(const options& opt, std::vector<row>& rows){
+        using U = Big::BigUint<N>;
+        std::mt19937_64 g(N);
+        std::vector<U> a, b, h, c, m;
+        std::vector<std::string> dec;
+        for(std::size_t i = 0; i < operands; ++i){
+            a.push_back(test::random<N>(g, N));
+            b.push_back(test::random<N>(g, N));
+            h.push_back(test::random<N>(g, N / 2));
+            c.push_back(test::random<N>(g, N / 2));
+            m.push_back(test::random<N>(g, N) | U(1ull));
+            std::ostringstream os;
+            os << a.back();
+            dec.push_back(os.str());
+        }
+
+        bench<N>(opt, rows, "add", [&](std::size_t i){
+            consume(a[i] + b[i]);
+        });
+        // half width operands so the product is exact
+        bench<N>(opt, rows, "mul", [&](std::size_t i){
+            consume(h[i] * c[i]);
+        });
+        // a half width operand times itself
+        bench<N>(opt, rows, "sqr", [&](std::size_t i){
+            consume(h[i] * h[i]);
+        });
+        // full width operands, only the low N bits of the product are kept
+        bench<N>(opt, rows, "mullo", [&](std::size_t i){
+            consume(a[i] * b[i]);
+        });
+        bench<N>(opt, rows, "div", [&](std::size_t i){
+            consume(a[i] / c[i]);
+        });
+        bench<N>(opt, rows, "to_dec", [&](std::size_t i){
+            std::ostringstream os;
+            os << a[i];
+            sink = static_cast<unsigned int>(os.str().size());
+        });
+        bench<N>(opt, rows, "from_dec", [&](std::size_t i){
+            std::istringstream is(dec[i]);
+            U x(0ull);
+            is >> x;
+            consume(x);
+        });
+        bench<N>(opt, rows, "powm", [&](std::size_t i){
+            consume(Big::powm(a[i] % m[i], b[i], m[i]));
+        });
+        bench<N>(opt, rows, "gcd", [&](std::size_t i){
+            consume(Big::gcd(a[i], b[i]));
+        });
+    }
+
+    template<std::size_t... Ns>
+    void run_all(const options& opt, std::vector<row>& rows){
+        (run<Ns>(opt, rows), ...);
+    }
+
+    void write_csv(std::ostream& os, const std::vector<row>& rows){
+        os << "op,bits,limbs,iterations,ns_per_op,limbs_per_ns";
+#ifdef BIG_STATS
+        Big::stats::for_each(Big::stats::counters{}, [&](const char* name, unsigned long long){
+            os << ',' << name;
+        });
+#endif
+        os << '\n';
+        for(const row& r : rows){
+            os << r.op << ',' << r.bits << ',' << r.limbs << ',' << r.iterations << ','
+               << r.ns_per_op << ',' << double(r.limbs) / r.ns_per_op;
+#ifdef BIG_STATS
+            Big::stats::for_each(r.stats, [&](const char*, unsigned long long value){
+                os << ',' << double(value) / double(r.iterations);
+            });
+#endif
+            os << '\n';
+        }
+    }
+
+    void write_json(std::ostream& os, const std::vector<row>& rows){
+        os << "[\n";
+        for(std::size_t i = 0; i < rows.size(); ++i){
+            const row& r = rows[i];
+            os << "  {\"op\": \"" << r.op << "\", \"bits\": " << r.bits << ", \"limbs\": " << r.limbs
+               << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.ns_per_op
+               << ", \"limbs_per_ns\": " << double(r.limbs) / r.ns_per_op;
+#ifdef BIG_STATS
+            os << ", \"stats\": {";
+            const char* sep = "";
+            Big::stats::for_each(r.stats, [&](const char* name, unsigned long long value){
+                os << sep << '"' << name << "\": " << double(value) / double(r.iterations);
+                sep = ", ";
+            });
+            os << '}';
+#endif
+            os << '}' << (i + 1 < rows.size() ? "," : "") << '\n';
+        }
+        os << "]\n";
+    }
+}
+
+int main(int argc, char* argv[]){
+    options opt;
+    bool ok = true;
+    for(int i = 1; i < argc && ok; i += 2){
+        // every option takes a value
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if(!value)
+            ok = false;
+        else if(!std::strcmp(argv[i], "--format"))
+            opt.format = value;
+        else if(!std::strcmp(argv[i], "--min-time")){
+            char* end = nullptr;
+            opt.min_ns = std::strtod(value, &end) * 1e6;
+            ok = end != value && !*end && opt.min_ns >= 0;
+        }else if(!std::strcmp(argv[i], "--ops"))
+            opt.ops = value;
+        else
+            ok = false;
+    }
+    if(!ok || (std::strcmp(opt.format, "csv") && std::strcmp(opt.format, "json"))){
+        std::cerr << "usage: " << argv[0] << " [--format csv|json] [--min-time ms]"
+                  << " [--ops add,mul,sqr,mullo,div,to_dec,from_dec,powm,gcd]\n";
+        return 1;
+    }
+
+    std::vector<row> rows;
+    run_all<128, 256, 512, 1024, 2048, 4096>(opt, rows);
+
+    if(!std::strcmp(opt.format, "json"))
+        write_json(std::cout, rows);
+    else
+        write_csv(std::cout, rows);
+    return 0;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file   BigInt/test/bytes.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Byte import, export and view tests
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "BigInt.hpp"
+#include "BigUint.hpp"
+#include "BigUintView.hpp"
+
+#include "random.hpp"
+
+namespace{
+    using Bytes = std::vector<unsigned char>;
+
+    // byte i of x counted from the least significant end
+    template<std::size_t N>
+    unsigned char byte(const Big::BigUint<N>& x, std::size_t i){
+        const Big::BigUint<N> b = (x >> (8 * i)) & Big::BigUint<N>(0xffull);
+        return static_cast<unsigned char>(static_cast<unsigned long long>(b));
+    }
+
+    template<std::size_t N>
+    void unsigned_round_trip(){
+        using U = Big::BigUint<N>;
+        std::mt19937_64 g(N);
+        for(int i = 0; i < 100; ++i){
+            const U x = i ? test::random<N>(g) : U(0ull);
+            const std::size_t minimal = (x.bit_length() + 7) / 8;
+            for(Big::byte_order order : {Big::byte_order::little, Big::byte_order::big}){
+                const bool big = order == Big::byte_order::big;
+                for(Big::byte_width width : {Big::byte_width::fixed, Big::byte_width::minimal}){
+                    const std::size_t size = width == Big::byte_width::fixed ? N / 8 : minimal;
+                    assert(Big::export_size(x, width) == size);
+
+                    Bytes out(N / 8 + 1, 0xa5);
+                    assert(Big::export_bytes(x, out.data(), order, width) == size);
+                    for(std::size_t j = 0; j < size; ++j)
+                        assert(out[big ? size - 1 - j : j] == byte(x, j));
+                    assert(out[size] == 0xa5);
+
+                    U y(1ull);
+                    assert(Big::import_bytes(y, out.data(), size, order));
+                    assert(y == x);
+                }
+            }
+        }
+    }
+
+    template<std::size_t N>
+    void unsigned_overflow(){
+        using U = Big::BigUint<N>;
+        // leading zero bytes beyond N bits still fit
+        Bytes in(N / 8 + 3, 0);
+        in[0] = 0x12;
+        U x(0ull);
+        assert(Big::import_bytes(x, in.data(), in.size()));
+        assert(x == U(0x12ull));
+        assert(Big::import_bytes(x, in.data(), in.size(), Big::byte_order::little));
+        std::reverse(in.begin(), in.end());
+        assert(Big::import_bytes(x, in.data(), in.size(), Big::byte_order::big));
+        assert(x == U(0x12ull));
+
+        // anything else is truncated modulo 2^N
+        in[1] = 1;
+        assert(!Big::import_bytes(x, in.data(), in.size(), Big::byte_order::big));
+        assert(x == U(0x12ull));
+        in.assign(N / 8 + 1, 0xff);
+        assert(!Big::import_bytes(x, in.data(), in.size()));
+        assert(x == U(0ull) - U(1ull));
+
+        assert(Big::import_bytes(x, in.data(), 0));
+        assert(x == U(0ull));
+    }
+
+    template<std::size_t N>
+    void signed_round_trip(){
+        using I = Big::BigInt<N>;
+        std::mt19937_64 g(N + 1);
+        for(int i = 0; i < 100; ++i){
+            I x(test::random<N>(g) >> 1);
+            if(i % 2)
+                -x;
+            for(Big::byte_order order : {Big::byte_order::little, Big::byte_order::big}){
+                for(Big::byte_width width : {Big::byte_width::fixed, Big::byte_width::minimal}){
+                    Bytes out(N / 8);
+                    const std::size_t size = Big::export_bytes(x, out.data(), order, width);
+                    assert(size == Big::export_size(x, width));
+                    I y(1ll);
+                    assert(Big::import_bytes(y, out.data(), size, order));
+                    assert(y == x);
+                    // one byte less loses the sign or a significant bit
+                    const std::size_t shorter = size ? size - 1 : 0;
+                    const bool fits = Big::import_bytes(y, out.data() + size - shorter, shorter, order);
+                    assert(width == Big::byte_width::fixed || !size || !fits || y != x);
+                }
+            }
+        }
+    }
+
+    // minimal two's complement widths and sign extension
+    void signed_edges(){
+        using I = Big::BigInt<64>;
+        const std::pair<long long, Bytes> cases[] = {
+            {0, {}}, {1, {0x01}}, {-1, {0xff}}, {127, {0x7f}}, {128, {0x80, 0x00}},
+            {-128, {0x80}}, {-129, {0x7f, 0xff}}, {255, {0xff, 0x00}}, {-256, {0x00, 0xff}},
+            {32767, {0xff, 0x7f}}, {-32769, {0xff, 0x7f, 0xff}},
+            {-9223372036854775807ll - 1, {0, 0, 0, 0, 0, 0, 0, 0x80}}};
+        for(const auto& c : cases){
+            const I x(c.first);
+            Bytes out(8);
+            out.resize(Big::export_bytes(x, out.data(), Big::byte_order::little, Big::byte_width::minimal));
+            assert(out == c.second);
+            I y(1ll);
+            assert(Big::import_bytes(y, c.second.data(), c.second.size()));
+            assert(y == x);
+        }
+
+        // big endian bytes into 32 bits, -1, -2^31, 2^31 and -2^31 - 1
+        using S = Big::BigInt<32>;
+        const std::pair<Bytes, long long> imports[] = {
+            {{0xff, 0xff, 0xff, 0xff, 0xff, 0xff}, -1}, {{0xff, 0x80, 0x00, 0x00, 0x00}, -2147483647ll - 1},
+            {{0x00, 0x80, 0x00, 0x00, 0x00}, 0}, {{0xff, 0x7f, 0xff, 0xff, 0xff}, 0}};
+        for(const auto& c : imports){
+            S x(0ll);
+            const bool fits = Big::import_bytes(x, c.first.data(), c.first.size(), Big::byte_order::big);
+            assert(fits == (c.second != 0) && (!fits || x == S(c.second)));
+        }
+    }
+
+    bool agrees(Big::BigUintView<256> va, Big::BigUintView<256> vb, const Big::BigUint<256>& a, const Big::BigUint<256>& b){
+        using V = Big::BigUintView<256>;
+        using U = Big::BigUint<256>;
+        return va == V(a) && va.value() == a && vb.value() == b && va.bit_length() == a.bit_length() &&
+               va + vb == a + b && va - vb == a - b && va * vb == a * b && va / vb == a / b && va % vb == a % b &&
+               (va ^ vb) == (a ^ b) && (va & vb) == (a & b) && (va | vb) == (a | b) &&
+               (va << 77) == (a << 77) && (va >> 77) == (a >> 77) &&
+               (va < vb) == (a < b) && (va <= vb) == (a <= b) && (va != vb) == (a != b) &&
+               static_cast<unsigned long long>(va) == static_cast<unsigned long long>(a) &&
+               std::hash<V>()(va) == std::hash<U>()(a);
+    }
+
+    // arithmetic on a view agrees with the owned value
+    void views(){
+        using U = Big::BigUint<256>;
+        using V = Big::BigUintView<256>;
+        std::mt19937_64 g(30);
+        for(int i = 0; i < 100; ++i){
+            const U a = test::random<256>(g);
+            const U b = test::random<256>(g) | U(1ull);
+
+            // a fixed width little endian export is the limb layout on a little endian host
+            unsigned char buffer[2 * 32];
+            Big::export_bytes(a, buffer);
+            Big::export_bytes(b, buffer + 32);
+            unsigned int limbs[2 * V::limb_count];
+            std::memcpy(limbs, buffer, sizeof limbs);
+            const V va(limbs);
+            const V vb(limbs + V::limb_count);
+
+            assert(agrees(va, vb, a, b));
+        }
+    }
+}
+
+int main(){
+    unsigned_round_trip<32>();
+    unsigned_round_trip<96>();
+    unsigned_round_trip<256>();
+    unsigned_overflow<32>();
+    unsigned_overflow<96>();
+    unsigned_overflow<256>();
+    signed_round_trip<96>();
+    signed_round_trip<256>();
+    signed_edges();
+    views();
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file   BigInt/test/literals.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Compile time literal and constant evaluation tests
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cassert>
+#include <type_traits>
+
+#include "BigInt.hpp"
+#include "BigUint.hpp"
+#include "BigMath.hpp"
+
+namespace{
+    using namespace Big::literals;
+
+    template<std::size_t N>
+    using U = Big::BigUint<N>;
+    template<std::size_t N>
+    using I = Big::BigInt<N>;
+
+    // widths deduced from the digit count, rounded up to whole limbs
+    static_assert(std::is_same<decltype(0_bu), U<32>>::value, "");
+    static_assert(std::is_same<decltype(255_bu), U<32>>::value, "");
+    static_assert(std::is_same<decltype(0xff_bu), U<32>>::value, "");
+    static_assert(std::is_same<decltype(0xffff'ffff_bu), U<32>>::value, "");
+    static_assert(std::is_same<decltype(0x1'0000'0000_bu), U<64>>::value, "");
+    static_assert(std::is_same<decltype(4294967295_bu), U<64>>::value, "");
+    static_assert(std::is_same<decltype(0777_bu), U<32>>::value, "");
+    static_assert(std::is_same<decltype(0b1111'1111'1111'1111'1111'1111'1111'1111'1_bu), U<64>>::value, "");
+    static_assert(std::is_same<decltype(340282366920938463463374607431768211455_bu), U<160>>::value, "");
+    static_assert(std::is_same<decltype(255_bi), I<32>>::value, "");
+    static_assert(std::is_same<decltype(0x7fff'ffff_bi), I<64>>::value, "");
+    static_assert(std::is_same<decltype(Big::literal<96>("1")), U<96>>::value, "");
+
+    // values in every base and with digit separators
+    static_assert(0_bu == U<32>(0ull), "");
+    static_assert(255_bu == U<32>(255ull), "");
+    static_assert(0xff_bu == U<32>(255ull) && 0XFF_bu == U<32>(255ull), "");
+    static_assert(0377_bu == U<32>(255ull), "");
+    static_assert(0b1111'1111_bu == U<32>(255ull), "");
+    static_assert(1'000'000_bu == U<32>(1000000ull), "");
+    static_assert(0x1'0000'0000_bu == U<64>(1ull << 32), "");
+    static_assert(18446744073709551615_bu == U<96>(~0ull), "");
+    static_assert(340282366920938463463374607431768211455_bu == (U<160>(1ull) << 128) - U<160>(1ull), "");
+    static_assert(0xffff'ffff'ffff'ffff'ffff'ffff'ffff'ffff_bu == U<128>(0ull) - U<128>(1ull), "");
+
+    static_assert(255_bi == I<32>(255ll), "");
+    static_assert(-255_bi == I<32>(-255ll), "");
+    static_assert(-0x8000'0000_bi == I<64>(-2147483647ll - 1), "");
+
+    // fixed widths
+    static_assert(Big::literal<64>("0xffff'ffff'ffff'ffff") == U<64>(~0ull), "");
+    static_assert(Big::literal<256>("0") == U<256>(0ull), "");
+    static_assert(Big::signed_literal<32>("2147483647") == I<32>(2147483647ll), "");
+    static_assert(Big::signed_literal<32>("-2147483648") == I<32>(-2147483647ll - 1), "");
+    static_assert(Big::signed_literal<32>("-0x1") == I<32>(-1ll), "");
+    static_assert(Big::signed_literal<128>("-170141183460469231731687303715884105728") ==
+                  (I<128>(1ll) << 127), "");
+
+    // the arithmetic evaluates at compile time
+    constexpr U<128> goldilocks = Big::literal<128>("0xffff'ffff'0000'0001");
+    static_assert(Big::powm(U<128>(7ull), goldilocks - U<128>(1ull), goldilocks) == U<128>(1ull), "");
+    static_assert(Big::literal<128>("340282366920938463463374607431768211455") /
+                  Big::literal<128>("18446744073709551617") == U<128>(~0ull), "");
+    static_assert(0xffff'ffff'ffff'ffff'ffff'ffff'ffff'ffff_bu % U<128>(1000000007ull) == U<128>(279632276ull), "");
+    static_assert(Big::gcd(Big::literal<256>("0x1'0000'0000'0000'0000") * U<256>(12ull),
+                           Big::literal<256>("0x1'0000'0000") * U<256>(18ull)) ==
+                  Big::literal<256>("0x6'0000'0000"), "");
+
+    // outside a constant expression a value that does not fit wraps
+    bool wraps(){
+        return Big::literal<32>("4294967297") == U<32>(1ull) &&
+               Big::literal<32>("0x1'0000'0000'0000'0002") == U<32>(2ull) &&
+               Big::signed_literal<32>("-4294967295") == I<32>(1ll);
+    }
+}
+
+int main(){
+    assert(wraps());
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file   BigInt/test/prime.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Primality test and prime search tests
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cassert>
+#include <random>
+#include <vector>
+
+#include "BigUint.hpp"
+#include "BigPrime.hpp"
+
+namespace{
+    using U = Big::BigUint<128>;
+
+    // hi * 2^64 + lo
+    U wide(unsigned long long hi, unsigned long long lo){
+        return (U(hi) << 64) + U(lo);
+    }
+
+    // agrees with a sieve of Eratosthenes below 2^16
+    void small(){
+        constexpr unsigned long long limit = 1ull << 16;
+        std::vector<bool> composite(limit);
+        composite[0] = composite[1] = true;
+        for(unsigned long long i = 2; i * i < limit; ++i)
+            if(!composite[i])
+                for(unsigned long long j = i * i; j < limit; j += i)
+                    composite[j] = true;
+        for(unsigned long long i = 0; i < limit; ++i)
+            assert(Big::is_probable_prime(U(i)) == !composite[i]);
+    }
+
+    void pseudoprimes(){
+        const U spsp37 = wide(17274, 16800704772356552677ull);
+        const U spsp41 = wide(179817, 5885577656943027709ull);
+
+        // strong pseudoprimes to base 2, the last two to all prime bases up to 37 and 41
+        for(const U& n : {U(2047ull), U(3277ull), U(4033ull), U(4681ull), U(8321ull), U(15841ull),
+                          U(29341ull), U(42799ull), U(49141ull), U(3215031751ull), U(2152302898747ull),
+                          U(3474749660383ull), U(341550071728321ull), U(3825123056546413051ull),
+                          spsp37, spsp41})
+            assert(!Big::is_probable_prime(n) && !Big::is_probable_prime(n, 8));
+
+        // Carmichael numbers pass the Fermat test to every coprime base
+        for(const U& n : {U(561ull), U(1105ull), U(1729ull), U(2465ull), U(2821ull), U(6601ull),
+                          U(8911ull), U(41041ull), U(825265ull), U(321197185ull), U(5394826801ull),
+                          U(232250619601ull), U(9746347772161ull)})
+            assert(!Big::is_probable_prime(n));
+
+        // strong Lucas pseudoprimes
+        for(const U& n : {U(5459ull), U(5777ull), U(10877ull), U(16109ull), U(18971ull), U(22499ull),
+                          U(24569ull), U(25199ull)})
+            assert(!Big::is_probable_prime(n));
+    }
+
+    void large(){
+        const U one(1ull);
+        assert(Big::is_probable_prime((one << 61) - one));
+        assert(Big::is_probable_prime((one << 89) - one));
+        assert(Big::is_probable_prime((one << 127) - one));
+        assert(Big::is_probable_prime(Big::BigUint<1024>(Big::BigUint<1024>(1ull) << 521) - Big::BigUint<1024>(1ull)));
+        assert(!Big::is_probable_prime(((one << 61) - one) * ((one << 61) - one)));
+        assert(!Big::is_probable_prime(((one << 31) - one) * ((one << 89) - one)));
+        assert(!Big::is_probable_prime((one << 67) - one));
+
+        // the largest primes below 2^64 and 2^128
+        assert(Big::is_probable_prime(U(18446744073709551557ull)));
+        assert(Big::is_probable_prime(U(0ull) - U(159ull)));
+        assert(!Big::is_probable_prime(U(0ull) - U(157ull)));
+    }
+
+    void next(){
+        assert(Big::next_prime(U(0ull)) == U(2ull));
+        assert(Big::next_prime(U(1ull)) == U(2ull));
+        assert(Big::next_prime(U(2ull)) == U(3ull));
+        assert(Big::next_prime(U(3ull)) == U(5ull));
+        assert(Big::next_prime(U(13ull)) == U(17ull));
+        assert(Big::next_prime(U(4294967290ull)) == U(4294967291ull));
+        assert(Big::next_prime(U(4294967291ull)) == U(4294967311ull));
+
+        // a maximal prime gap of 1132, longer than a sieve window
+        assert(Big::next_prime(U(1693182318746371ull)) == U(1693182318747503ull));
+        assert(Big::next_prime(U(1693182318746371ull), 4) == U(1693182318747503ull));
+
+        // the first prime above 2^64, and none left below 2^N
+        assert(Big::next_prime(U(18446744073709551556ull)) == U(18446744073709551557ull));
+        const U above = wide(1, 13);
+        assert(Big::next_prime(U(18446744073709551557ull)) == above);
+        assert(Big::next_prime(Big::BigUint<64>(18446744073709551557ull)) == Big::BigUint<64>(0ull));
+        assert(Big::next_prime(U(0ull) - U(160ull)) == U(0ull) - U(159ull));
+        assert(Big::next_prime(U(0ull) - U(159ull)) == U(0ull));
+    }
+
+    void search(){
+        std::mt19937_64 g(28);
+        for(std::size_t bits : {2u, 3u, 17u, 64u, 100u, 128u}){
+            const U p = Big::random_prime<128>(bits, g);
+            assert(p.bit_length() == bits);
+            assert(Big::is_probable_prime(p));
+        }
+        assert(Big::random_prime<128>(1, g) == U(0ull));
+        assert(Big::random_prime<128>(129, g) == U(0ull));
+    }
+}
+
+int main(){
+    small();
+    pseudoprimes();
+    large();
+    next();
+    search();
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file   BigInt/test/products.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Multiplication kernel and combinatorial product tests
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cassert>
+#include <random>
+#include <vector>
+
+#include "BigUint.hpp"
+#include "BigMath.hpp"
+
+namespace{
+    using Big::detail::limb;
+
+    std::vector<limb> random(std::mt19937_64& g, std::size_t n){
+        std::vector<limb> x(n);
+        for(limb& l : x)
+            l = static_cast<limb>(g());
+        return x;
+    }
+
+    // Karatsuba agrees with the schoolbook product on both sides of every recursion threshold
+    void kernels(){
+        constexpr std::size_t t = Big::detail::karatsuba_threshold;
+        std::mt19937_64 g(29);
+        for(std::size_t an : {t - 1, t, t + 1, 2 * t - 1, 2 * t, 2 * t + 1, 3 * t, 8 * t - 1, 8 * t, 8 * t + 1}){
+            for(std::size_t bn : {std::size_t(1), t - 1, t, t + 1, 2 * t + 1, 8 * t}){
+                if(bn > an)
+                    continue;
+                for(int i = 0; i < 4; ++i){
+                    std::vector<limb> a = random(g, an);
+                    std::vector<limb> b = random(g, bn);
+                    // all ones maximise the carries, a zero high half flips the sign of the middle term
+                    if(i == 1)
+                        a.assign(an, ~limb(0));
+                    if(i == 1)
+                        b.assign(bn, ~limb(0));
+                    if(i == 2)
+                        std::fill(a.begin() + an / 2, a.end(), 0);
+                    if(i == 3)
+                        std::fill(b.begin(), b.begin() + bn / 2, 0);
+
+                    std::vector<limb> expected(an + bn);
+                    Big::detail::mul(expected.data(), a.data(), an, b.data(), bn);
+
+                    std::vector<limb> r(an + bn);
+                    std::vector<limb> scratch(Big::detail::karatsuba_scratch(bn));
+                    Big::detail::mul_fast(r.data(), a.data(), an, b.data(), bn, scratch.data());
+                    assert(r == expected);
+
+                    if(an == bn){
+                        std::fill(r.begin(), r.end(), 0);
+                        Big::detail::mul_karatsuba(r.data(), a.data(), b.data(), an, scratch.data());
+                        assert(r == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    template<std::size_t N>
+    bool agrees(const Big::BigUint<N>& a, const Big::BigUint<N>& b){
+        Big::BigUint<N> expected(0ull);
+        Big::detail::mul_lo(expected.limbs(), a.limbs(), b.limbs(), Big::BigUint<N>::limb_count);
+        Big::BigUint<N> c = a;
+        c *= b;
+        return a * b == expected && b * a == expected && c == expected;
+    }
+
+    // the truncated product agrees with the schoolbook one for every operand length
+    template<std::size_t N>
+    void truncated(){
+        using U = Big::BigUint<N>;
+        constexpr std::size_t n = U::limb_count;
+        std::mt19937_64 g(N);
+        for(std::size_t an = 1; an <= n; an += an < 20 ? 1 : 7){
+            for(std::size_t bn = 1; bn <= an; bn += bn < 20 ? 1 : 7){
+                U a(0ull);
+                U b(0ull);
+                const std::vector<limb> x = random(g, an);
+                const std::vector<limb> y = random(g, bn);
+                std::copy(x.begin(), x.end(), a.limbs());
+                std::copy(y.begin(), y.end(), b.limbs());
+
+                assert(agrees(a, b));
+            }
+        }
+    }
+
+    // against the running product 1 * 2 * ... * n modulo 2^N, past the point where it becomes 0
+    template<std::size_t N>
+    void factorials(unsigned long long last, unsigned long long step){
+        using U = Big::BigUint<N>;
+        U expected(1ull);
+        for(unsigned long long n = 0; n <= last; ++n){
+            if(n)
+                expected *= U(n);
+            if(n % step == 0 || n + step > last){
+                assert(Big::factorial<N>(n) == expected);
+                assert(Big::factorial<N>(n, 3) == expected);
+            }
+        }
+        assert(expected == U(0ull));
+        assert(Big::factorial<N>(1ull << 32) == U(0ull));
+        assert(Big::factorial<N>(~0ull) == U(0ull));
+    }
+
+    // against Pascal's triangle
+    void binomials(){
+        using U = Big::BigUint<256>;
+        std::vector<U> row{U(1ull)};
+        for(unsigned long long n = 0; n <= 400; ++n){
+            for(unsigned long long k = 0; k <= n + 1; k += n < 100 ? 1 : 13)
+                assert(Big::binomial<256>(n, k) == (k <= n ? row[k] : U(0ull)));
+            std::vector<U> next(row.size() + 1, U(0ull));
+            for(std::size_t k = 0; k < row.size(); ++k){
+                next[k] += row[k];
+                next[k + 1] += row[k];
+            }
+            row = next;
+        }
+        assert(Big::binomial<256>(400, 200, 4) == Big::binomial<256>(400, 200));
+        assert(Big::binomial<256>(10000019, 1) == U(10000019ull));
+        assert(Big::binomial<256>(10000019, 2) == U(10000019ull * 5000009ull));
+        assert(Big::binomial<256>(10000019, 3) == U(10000019ull * 5000009ull) * U(3333339ull));
+    }
+
+    // factors beyond 2^32, against n (n - 1) (n - 2) / 6 and the recurrences modulo 2^256
+    void wide_binomials(){
+        using U = Big::BigUint<256>;
+        for(unsigned long long n : {1ull << 32, (1ull << 32) + 5, 1ull << 63, ~0ull}){
+            const U x(n);
+            assert(Big::binomial<256>(n, 0) == U(1ull));
+            assert(Big::binomial<256>(n, 1) == x);
+            assert(Big::binomial<256>(n, n - 1) == x);
+            assert(Big::binomial<256>(n, 3) == x * (x - U(1ull)) * (x - U(2ull)) / U(6ull));
+            assert(Big::binomial<256>(n, n) == U(1ull));
+        }
+
+        const unsigned long long n = (1ull << 40) + 7;
+        for(unsigned long long k : {2ull, 100ull, 4099ull, 40000ull}){
+            const U c = Big::binomial<256>(n, k);
+            const U below = Big::binomial<256>(n - 1, k - 1);
+            assert(c == below + Big::binomial<256>(n - 1, k));
+            assert(U(k) * c == U(n) * below);
+        }
+        assert(Big::binomial<256>(n, 40000, 4) == Big::binomial<256>(n, 40000));
+
+        // 63 carries adding 2^62 - 1 and 2^62 + 1
+        assert(Big::binomial<32>(1ull << 63, (1ull << 62) - 1) == Big::BigUint<32>(0ull));
+    }
+
+    // against a sieve, across the segments of the prime search
+    void long_primorials(){
+        using U = Big::BigUint<256>;
+        constexpr unsigned long long limit = 300000;
+        std::vector<bool> composite(limit + 1);
+        U expected(1ull);
+        const unsigned long long checks[] = {131071, 131073, 131075, 262145, 262147, 262149, limit};
+        std::size_t next = 0;
+        for(unsigned long long n = 2; n <= limit; ++n){
+            if(!composite[n]){
+                expected *= U(n);
+                for(unsigned long long j = n * n; j <= limit; j += n)
+                    composite[j] = true;
+            }
+            if(n == checks[next]){
+                assert(Big::primorial<256>(n) == expected);
+                ++next;
+            }
+        }
+        assert(next == 7);
+    }
+
+    // against trial division
+    void primorials(){
+        using U = Big::BigUint<4096>;
+        U expected(1ull);
+        for(unsigned long long n = 0; n <= 4000; ++n){
+            bool prime = n >= 2;
+            for(unsigned long long d = 2; d * d <= n && prime; ++d)
+                prime = n % d;
+            if(prime)
+                expected *= U(n);
+            if(n % 97 == 0 || n == 4000)
+                assert(Big::primorial<4096>(n) == expected);
+        }
+        assert(Big::primorial<4096>(4000, 4) == expected);
+    }
+
+    void products(){
+        using U = Big::BigUint<2048>;
+        std::mt19937_64 g(30);
+        std::vector<U> values;
+        U expected(1ull);
+        for(int i = 0; i < 100; ++i){
+            values.push_back(U(static_cast<unsigned long long>(g())) << (g() % 64));
+            expected *= values.back();
+            assert(Big::product(values.data(), values.size()) == expected);
+        }
+        assert(Big::product(values.data(), values.size(), 4) == expected);
+        assert(Big::product(values.data(), 0) == U(1ull));
+    }
+}
+
+int main(){
+    kernels();
+    truncated<512>();
+    truncated<1024>();
+    truncated<4096>();
+    truncated<4128>();
+    factorials<256>(300, 1);
+    factorials<4096>(4200, 29);
+    binomials();
+    wide_binomials();
+    primorials();
+    long_primorials();
+    products();
+    return 0;
+}
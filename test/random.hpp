@@ -0,0 +1,59 @@
+/**
+ * @file   BigInt/test/random.hpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Random operands shared by the tests and benchmarks
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BIGINT_TEST_RANDOM_HPP
+#define BIGINT_TEST_RANDOM_HPP
+
+#include <cstddef>
+#include <random>
+
+#include "BigUint.hpp"
+
+namespace test{
+    // random value below 2^bits, every limb drawn from g
+    template<std::size_t N>
+    Big::BigUint<N> random(std::mt19937_64& g, std::size_t bits){
+        Big::BigUint<N> x(0ull);
+        for(std::size_t i = 0; i < x.limb_count; ++i)
+            x.limbs()[i] = static_cast<unsigned int>(g());
+        if(bits < N)
+            x >>= N - bits;
+        return x;
+    }
+
+    // random value with a random bit length of at most N
+    template<std::size_t N>
+    Big::BigUint<N> random(std::mt19937_64& g){
+        return random<N>(g, N - g() % N);
+    }
+}
+
+#endif /* BIGINT_TEST_RANDOM_HPP */
@@ -0,0 +1,162 @@
+/**
+ * @file   BigInt/test/roots.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  Integer roots and perfect power tests
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cassert>
+#include <random>
+
+#include "BigInt.hpp"
+#include "BigUint.hpp"
+#include "BigMath.hpp"
+
+#include "random.hpp"
+
+namespace{
+    using U = Big::BigUint<256>;
+    using I = Big::BigInt<256>;
+    using W = Big::BigUint<1024>;
+
+    W power(const W& x, unsigned long long k){
+        W y(1ull);
+        for(unsigned long long i = 0; i < k; ++i)
+            y *= x;
+        return y;
+    }
+
+    // y = floor(x^(1/k)) exactly when y^k <= x < (y + 1)^k
+    bool is_root(const U& x, const U& y, unsigned long long k){
+        const W wx(x);
+        return power(W(y), k) <= wx && wx < power(W(y) + W(1ull), k);
+    }
+
+    void identities(){
+        std::mt19937_64 g(27);
+        for(int i = 0; i < 200; ++i){
+            const U x = test::random<256>(g);
+
+            U rem(0ull);
+            const U s = Big::sqrtrem(x, rem);
+            assert(s == Big::isqrt(x));
+            assert(is_root(x, s, 2));
+            assert(rem == x - s * s);
+
+            for(unsigned long long k : {2ull, 3ull, 4ull, 5ull, 7ull, 64ull, 255ull})
+                assert(is_root(x, Big::iroot(x, k), k));
+
+            // exact powers and their neighbours
+            const U y = x >> 192;
+            const U cube = y * y * y;
+            assert(Big::iroot(cube, 3) == y);
+            if(y > U(1ull)){
+                assert(Big::iroot(cube - U(1ull), 3) == y - U(1ull));
+                assert(Big::is_perfect_power(cube));
+            }
+        }
+
+        const U max = ~U(0ull);
+        assert(Big::isqrt(max) == (U(1ull) << 128) - U(1ull));
+        assert(Big::iroot(max, 1) == max);
+        assert(Big::iroot(max, 256) == U(1ull));
+        assert(Big::iroot(max, 0) == U(0ull));
+        assert(Big::isqrt(U(0ull)) == U(0ull));
+        assert(Big::isqrt(U(1ull)) == U(1ull));
+        assert(Big::isqrt(U(3ull)) == U(1ull));
+        assert(Big::isqrt(U(4ull)) == U(2ull));
+    }
+
+    void signed_roots(){
+        assert(Big::iroot(I(-27ll), 3) == I(-3ll));
+        assert(Big::iroot(I(-28ll), 3) == I(-3ll));
+        assert(Big::iroot(I(-26ll), 3) == I(-2ll));
+        assert(Big::iroot(I(-16ll), 4) == I(0ll));
+        assert(Big::isqrt(I(-4ll)) == I(0ll));
+
+        I rem(0ll);
+        assert(Big::sqrtrem(I(-5ll), rem) == I(0ll));
+        assert(rem == I(-5ll));
+        assert(Big::sqrtrem(I(50ll), rem) == I(7ll));
+        assert(rem == I(1ll));
+    }
+
+    void perfect_powers(){
+        const U one(1ull);
+
+        // 0 = 0^k and 1 = 1^k count as powers
+        assert(Big::is_perfect_power(U(0ull)));
+        assert(Big::is_perfect_power(one));
+        assert(Big::is_perfect_square(U(0ull)));
+        assert(Big::is_perfect_square(one));
+        assert(!Big::is_perfect_power(U(2ull)));
+        assert(!Big::is_perfect_square(U(2ull)));
+
+        assert(Big::is_perfect_power(U(4ull)));
+        assert(Big::is_perfect_power(U(8ull)));
+        assert(Big::is_perfect_power(U(36ull)));
+        assert(!Big::is_perfect_power(U(72ull)));
+        assert(Big::is_perfect_power(one << 255));
+        assert(Big::is_perfect_power(one << 254));
+        assert(!Big::is_perfect_power((one << 255) + one));
+        assert(!Big::is_perfect_power((one << 255) - one));
+
+        // powers of large odd bases, with and without a power of two factor
+        const U p(0x100000000000000dull);
+        assert(Big::is_perfect_power(p * p * p));
+        assert(Big::is_perfect_power((p * p * p) << 3));
+        assert(!Big::is_perfect_power((p * p * p) << 1));
+        assert(!Big::is_perfect_power(p * p * p * U(3ull)));
+        assert(Big::is_perfect_square(p * p));
+        assert(!Big::is_perfect_square(p * p * p));
+        assert(!Big::is_perfect_square(p * p + one));
+        assert(!Big::is_perfect_square(p * p - one));
+
+        U t(1ull);
+        for(int i = 0; i < 161; ++i)
+            t *= U(3ull);
+        assert(Big::is_perfect_power(t));
+        assert(!Big::is_perfect_square(t));
+        assert(!Big::is_perfect_power(t + U(2ull)));
+
+        // negative numbers are only odd powers
+        assert(Big::is_perfect_power(I(-1ll)));
+        assert(Big::is_perfect_power(I(-8ll)));
+        assert(Big::is_perfect_power(I(-64ll)));
+        assert(!Big::is_perfect_power(I(-4ll)));
+        assert(!Big::is_perfect_power(I(-16ll)));
+        assert(!Big::is_perfect_square(I(-4ll)));
+        assert(Big::is_perfect_square(I(49ll)));
+    }
+}
+
+int main(){
+    identities();
+    signed_roots();
+    perfect_powers();
+    return 0;
+}
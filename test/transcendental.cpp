@@ -0,0 +1,300 @@
+/**
+ * @file   BigInt/test/transcendental.cpp
+ * @author Peter Züger
+ * @date   29.03.2020
+ * @brief  BigFloat constants and transcendental functions
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Philippe Peter
+ * Copyright (c) 2020 Peter Züger
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cassert>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "BigFloat.hpp"
+#include "BigMath.hpp"
+
+namespace{
+    // reference values to 60 significant digits
+    const char* const pi   = "3.141592653589793238462643383279502884197169399375105820974945";
+    const char* const e    = "2.718281828459045235360287471352662497757247093699959574966968";
+    const char* const ln2  = "0.6931471805599453094172321214581765680755001343602552541206800";
+
+    struct reference{
+        const char* x;
+        const char* y;
+    };
+
+    const reference exps[] = {
+        {"0.75",  "2.117000016612674668545369819837095610134491584702403421779133"},
+        {"-2.25", "0.1053992245618643367832176892406980972684910733772778671488441"},
+        {"100.5", "4.431955909845895416010706197956481689589948187063064907487691e43"},
+    };
+
+    const reference logs[] = {
+        {"0.75",      "-0.2876820724517809274392190059938274315035097108977610565066657"},
+        {"3.5",       "1.252762968495367995688120621985003161561584595221605934338710"},
+        {"0.0078125", "-4.852030263919617165920624850207235976528500940521786778844760"},
+        {"12345.5",   "9.421046903186709322307583053261518805365870841523446757274055"},
+    };
+
+    const reference sins[] = {
+        {"0.75",  "0.6816387600233341667332419527798939353383823946592299092136253"},
+        {"-2.25", "-0.7780731968879212414109666755877573208044607429102214174525278"},
+        {"100.5", "-0.03095996678327134474297531253373934619786689505188714191641970"},
+    };
+
+    // sin and cos of 3 * 2^e, far beyond the range of a long long quadrant count
+    struct huge{
+        long long exponent;
+        const char* sin;
+        const char* cos;
+    };
+
+    const huge huges[] = {
+        {64,     "0.07074296264777335628903304987775948815445377858330043755457491",
+                 "-0.9974945780483299166970102798421469741658377206974147235802180"},
+        {2000,   "-0.5434225478256138190045764541133544481497031444670446392671277",
+                 "-0.8394593108154310427087324540808371153012628762674203376305002"},
+        {100000, "-0.9409225205879486145449123060172504506135361359331245871327637",
+                 "-0.3386219281889780622275422138904075954721946488345247421516380"},
+    };
+
+    const reference atans[] = {
+        {"0.75",  "0.6435011087932843868028092287173226380415105911153123828656061"},
+        {"-2.25", "-1.152571997215667518040149862612751379749472750953004972222704"},
+        {"100.5", "1.560846406402091449778451867140997366388211994098855670142543"},
+    };
+
+    const reference exp2s[] = {
+        {"0.75",  "1.681792830507429086062250952466429790080068524713569021626452"},
+        {"-2.25", "0.2102241038134286357577813690583037237600085655891961277033065"},
+        {"100.5", "1.792728671193156477399422023278661496394239222564273688025834e30"},
+    };
+
+    const reference exp10s[] = {
+        {"0.75",  "5.623413251903490803949510397764812314682510430986916640816894"},
+        {"-2.25", "0.005623413251903490803949510397764812314682510430986916640816894"},
+        {"10.5",  "3.162277660168379331998893544432718533719555139325216826857505e10"},
+    };
+
+    const reference log2s[] = {
+        {"0.75",      "-0.4150374992788438185462610560521834912401855923075189395442473"},
+        {"3.5",       "1.807354922057604107441969317231830808641026625966140783677292"},
+        {"0.0078125", "-7"},
+        {"12345.5",   "13.59169764720979168916943500293899928804587901763238527405298"},
+    };
+
+    const reference log10s[] = {
+        {"0.75",      "-0.1249387366082999531324498861938707443362508987335212177909893"},
+        {"3.5",       "0.5440680443502756354984773638681431667153825148618568651932075"},
+        {"0.0078125", "-2.107209969647868366496172263071451187377329170234759789172992"},
+        {"12345.5",   "4.091508683805707004919836907107455180670293638157327098544870"},
+    };
+
+    const reference sinhs[] = {
+        {"0.75",  "0.8223167319358299807036616344469138485821440027829633696917375"},
+        {"-2.25", "-4.691168305898330691883575677635520163250866947142554571477302"},
+        {"100.5", "2.215977954922947708005353098978240844794974093531532453743846e43"},
+    };
+
+    const reference coshs[] = {
+        {"0.75",  "1.294683284676844687841708185390181761552347581919440052087395"},
+        {"-2.25", "4.796567530460195028666793366876218260519358020519832438626146"},
+        {"100.5", "2.215977954922947708005353098978240844794974093531532453743846e43"},
+    };
+
+    const reference tanhs[] = {
+        {"0.75",  "0.6351489523872873192144343573124964950924816871618092332201099"},
+        {"-2.25", "-0.9780261147388136399227292430061831658647532311712825735748286"},
+        {"10.5",  "0.9999999984834879155675231063984413137277748176448207829235925"},
+    };
+
+    const reference asins[] = {
+        {"0.75",  "0.8480620789814810080529443389984180800733662132631126428607182"},
+        {"-0.25", "-0.2526802551420786534856574369937109722521937330968381936339238"},
+    };
+
+    const reference acoss[] = {
+        {"0.75",  "0.7227342478134156111783773526413333620252184864244402676267541"},
+        {"-0.25", "1.823476581936975272716979128633462414350778432784391104121396"},
+    };
+
+    const reference asinhs[] = {
+        {"0.75",  "0.6931471805599453094172321214581765680755001343602552541206800"},
+        {"-2.25", "-1.550157956869062214979630554511670518618429183609674877802271"},
+        {"100.5", "5.303329659002721902971702322389680402563752137044997982988642"},
+    };
+
+    const reference acoshs[] = {
+        {"3.5",     "1.924847300238413789991035653697473692540737337542642078644073"},
+        {"12345.5", "10.11419408210635705940434330133677987670830743618350651423098"},
+    };
+
+    const reference atanhs[] = {
+        {"0.75",  "0.9729550745276566525526763717215898648185423647909305942296951"},
+        {"-0.25", "-0.2554128118829953416027570481518309674390553982228841350889768"},
+    };
+
+    template<class F>
+    F parse(const char* s){
+        F x;
+        std::istringstream(s) >> x;
+        return x;
+    }
+
+    // |x - ref| <= |ref| * 2^-(p - 8)
+    template<std::size_t p>
+    bool close(const Big::BigFloat<p, 2, 32>& x, const char* ref){
+        using F = Big::BigFloat<p, 2, 32>;
+        const F y = parse<F>(ref);
+        return abs(x - y) <= ldexp(abs(y), 8 - static_cast<long long>(p));
+    }
+
+    template<std::size_t p>
+    bool reduces(const huge& h){
+        using F = Big::BigFloat<p, 2, 32>;
+        const F x = ldexp(F(3ull), h.exponent);
+        F y(x);
+        -y;
+        return close(sin(x), h.sin) && close(cos(x), h.cos) && sin(y) == -sin(x) && cos(y) == cos(x);
+    }
+
+    // past the reduction limit, where sin, cos and tan yield 0
+    template<class F>
+    bool vanishes(long long exponent){
+        const F x = ldexp(F(3ull), exponent);
+        return !sin(x).mantissa() && !cos(x).mantissa() && !tan(x).mantissa();
+    }
+
+    // sin^2 + cos^2 = 1 and log(exp(x)) = x to 2^-(p - 8)
+    template<std::size_t p>
+    bool identities(const char* s){
+        using F = Big::BigFloat<p, 2, 32>;
+        const F x = parse<F>(s);
+        const F sin_x = sin(x);
+        const F cos_x = cos(x);
+        const F one(1ull);
+        const F tolerance = ldexp(one, 8 - static_cast<long long>(p));
+        return abs(sin_x * sin_x + cos_x * cos_x - one) <= tolerance && abs(log(exp(x)) - x) <= abs(x) * tolerance;
+    }
+
+    // the constants against their references, which hold 192 bits, and their inverse functions
+    template<std::size_t p>
+    bool constants(){
+        using F = Big::BigFloat<p, 2, 32>;
+        using R = Big::BigFloat<192, 2, 32>;
+        const F pi_p = Big::const_pi<F>();
+        const F e_p = Big::const_e<F>();
+        const F one(1ull);
+        const F tolerance = ldexp(one, 8 - static_cast<long long>(p));
+        return close(R(pi_p), pi) && close(R(e_p), e) &&
+               abs(ldexp(atan(one), 2) - pi_p) <= ldexp(tolerance, 2) && abs(log(e_p) - one) <= tolerance;
+    }
+
+    // readers at mixed precisions race to fill and extend the caches
+    void concurrent(){
+        bool (*const reads[])() = {constants<256>, constants<1024>, constants<512>, constants<2048>};
+        constexpr std::size_t n = sizeof(reads) / sizeof(reads[0]);
+        bool ok[2 * n] = {};
+        std::vector<std::thread> threads;
+        for(std::size_t t = 0; t < 2 * n; ++t){
+            threads.emplace_back([&reads, &ok, t]{
+                bool all = true;
+                for(std::size_t i = 0; i < n; ++i)
+                    all = reads[(t + i) % n]() && all;
+                ok[t] = all;
+            });
+        }
+        for(std::thread& t : threads)
+            t.join();
+        for(const bool b : ok)
+            assert(b);
+    }
+
+    template<std::size_t p>
+    void test(){
+        using F = Big::BigFloat<p, 2, 32>;
+
+        assert(close(Big::const_pi<F>(), pi));
+        assert(close(Big::const_e<F>(), e));
+        assert(close(Big::const_log2<F>(), ln2));
+
+        for(const reference& r : exps)
+            assert(close(exp(parse<F>(r.x)), r.y));
+        for(const reference& r : logs)
+            assert(close(log(parse<F>(r.x)), r.y));
+        for(const reference& r : sins)
+            assert(close(sin(parse<F>(r.x)), r.y));
+        for(const reference& r : atans)
+            assert(close(atan(parse<F>(r.x)), r.y));
+        for(const reference& r : asins)
+            assert(close(asin(parse<F>(r.x)), r.y));
+        for(const reference& r : acoss)
+            assert(close(acos(parse<F>(r.x)), r.y));
+
+        for(const reference& r : sinhs)
+            assert(close(sinh(parse<F>(r.x)), r.y));
+        for(const reference& r : coshs)
+            assert(close(cosh(parse<F>(r.x)), r.y));
+        for(const reference& r : tanhs)
+            assert(close(tanh(parse<F>(r.x)), r.y));
+        for(const reference& r : asinhs)
+            assert(close(asinh(parse<F>(r.x)), r.y));
+        for(const reference& r : acoshs)
+            assert(close(acosh(parse<F>(r.x)), r.y));
+        for(const reference& r : atanhs)
+            assert(close(atanh(parse<F>(r.x)), r.y));
+
+        for(const reference& r : exp2s)
+            assert(close(exp2(parse<F>(r.x)), r.y));
+        for(const reference& r : exp10s)
+            assert(close(exp10(parse<F>(r.x)), r.y));
+        for(const reference& r : log2s)
+            assert(close(log2(parse<F>(r.x)), r.y));
+        for(const reference& r : log10s)
+            assert(close(log10(parse<F>(r.x)), r.y));
+
+        for(const huge& h : huges)
+            assert(reduces<p>(h));
+        assert(vanishes<F>(1ll << 22));
+        using W = Big::BigFloat<p, 2, 64>;
+        assert(vanishes<W>(1ll << 61));
+    }
+}
+
+int main(){
+    // while the caches are empty
+    concurrent();
+
+    // the lower precision first, so the cached constants are extended
+    test<128>();
+    test<192>();
+
+    for(const char* x : {"0.75", "-2.25", "100.5"})
+        assert(identities<4096>(x));
+    return 0;
+}